@@ -112,8 +112,8 @@ namespace gallus
 			/// <summary>
 			/// Sets the clipboard data for the editor.
 			/// </summary>
-			/// <param name="a_Data">The Data object to set as the clipboard content.</param>
-			void SetClipboard(core::Data& a_Data);
+			/// <param name="a_Data">The Data object to move into the clipboard, left empty.</param>
+			void SetClipboard(core::Data&& a_Data);
 		private:
 			/// <summary>
 			/// Initializes the thread.
@@ -15,6 +15,7 @@
 #include "editor/imgui/windows/ExplorerWindow.h"
 #include "editor/imgui/windows/HierarchyWindow.h"
 #include "editor/imgui/windows/InspectorWindow.h"
+#include "editor/imgui/windows/ECSStatsWindow.h"
 #include "core/FileUtils.h"
 
 namespace gallus
@@ -106,6 +107,8 @@ namespace gallus
 				void SetPreviewTexture(const fs::path& a_Path);
 				graphics::dx12::Texture* GetPreviewTexture() const;
 
+				HierarchyWindow& GetHierarchyWindow();
+
 				void Update();
 				fs::path m_PreviewPath;
 			private:
@@ -135,6 +138,7 @@ namespace gallus
 				ExplorerWindow m_ExplorerWindow;
 				HierarchyWindow m_HierarchyWindow;
 				InspectorWindow m_InspectorWindow;
+				ECSStatsWindow m_ECSStatsWindow;
 
 				// Preview texture in the Inspector window.
 				graphics::dx12::Texture* m_PreviewTexture = nullptr;
@@ -13,6 +13,9 @@ namespace gallus
 		struct EntityID;
 		class Component;
 		class AbstractECSSystem;
+
+		template <class ComponentType>
+		class ComponentPool;
 	}
 	namespace editor
 	{
@@ -59,6 +62,11 @@ namespace gallus
 				/// </summary>
 				virtual void RenderInner() = 0;
 
+				/// <summary>
+				/// Marks the component as changed after the UI edited it. Looking at a component does not count as a change.
+				/// </summary>
+				virtual void MarkComponentChanged() = 0;
+
 				/// <summary>
 				/// Retrieves the name of the component UI.
 				/// </summary>
@@ -87,9 +95,8 @@ namespace gallus
 				/// </summary>
 				/// <param name="a_Window">The ImGui window for rendering the view.</param>
 				/// <param name="a_EntityID">The EntityID associated with the component being rendered.</param>
-				/// <param name="a_Component">The component to render.</param>
 				/// <param name="a_System">The system managing the component.</param>
-				ComponentUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID, C& a_Component, S& a_System) : ComponentBaseUIView(a_Window, a_EntityID), m_Component(a_Component), m_System(a_System)
+				ComponentUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID, S& a_System) : ComponentBaseUIView(a_Window, a_EntityID), m_System(a_System)
 				{}
 
 				/// <summary>
@@ -97,7 +104,12 @@ namespace gallus
 				/// </summary>
 				void Render() override
 				{
-					RenderBaseComponent(m_Component, m_System);
+					C* component = GetComponent();
+					if (!component)
+					{
+						return;
+					}
+					RenderBaseComponent(*component, m_System);
 				}
 
 				/// <summary>
@@ -105,7 +117,29 @@ namespace gallus
 				/// </summary>
 				void RenderInner() override = 0;
 			protected:
-				C& m_Component; /// Reference to the specific component being rendered.
+				/// <summary>
+				/// Retrieves the component being rendered. Components live in densely packed pools that move
+				/// when other components are added or removed, so the component is looked up every time instead of cached.
+				/// The lookup does not mark the component as changed, call MarkComponentChanged after editing it.
+				/// </summary>
+				/// <returns>Pointer to the component, or nullptr if it has been removed.</returns>
+				C* GetComponent()
+				{
+					gameplay::ComponentPool<C>& pool = m_System.GetComponents();
+					const uint32_t slot = pool.GetSlot(m_EntityID);
+					return slot == gameplay::ComponentPool<C>::INVALID_SLOT ? nullptr : &pool.GetComponents()[slot];
+				}
+
+				void MarkComponentChanged() override
+				{
+					gameplay::ComponentPool<C>& pool = m_System.GetComponents();
+					const uint32_t slot = pool.GetSlot(m_EntityID);
+					if (slot != gameplay::ComponentPool<C>::INVALID_SLOT)
+					{
+						pool.MarkChanged(slot);
+					}
+				}
+
 				S& m_System; /// Reference to the system managing the component.
 			};
 		}
@@ -26,9 +26,8 @@ namespace gallus
 				/// </summary>
 				/// <param name="a_Window">The ImGui window for rendering the view.</param>
 				/// <param name="a_EntityID">The entity ID associated with the transform component.</param>
-				/// <param name="a_MeshComponent">The MeshComponent to display and edit.</param>
 				/// <param name="a_System">The MeshSystem responsible for managing the MeshComponent.</param>
-				MeshComponentUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID, gameplay::MeshComponent& a_MeshComponent, gameplay::MeshSystem& a_System) : ComponentUIView(a_Window, a_EntityID, a_MeshComponent, a_System)
+				MeshComponentUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID, gameplay::MeshSystem& a_System) : ComponentUIView(a_Window, a_EntityID, a_System)
 				{}
 			private:
 				/// <summary>
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef _EDITOR
+
+#include "editor/imgui/windows/BaseWindow.h"
+
+#include <vector>
+
+#include "gameplay/ECSStats.h"
+
+namespace gallus
+{
+	namespace editor
+	{
+		namespace imgui
+		{
+			class ImGuiWindow;
+
+			/// <summary>
+			/// A window that displays the memory and occupancy of the ECS and every component pool,
+			/// used to find component types that take up more memory than they should.
+			/// </summary>
+			class ECSStatsWindow : public BaseWindow
+			{
+			public:
+				/// <summary>
+				/// Constructs an ECS statistics window.
+				/// </summary>
+				/// <param name="a_Window">The ImGui window for rendering the view.</param>
+				ECSStatsWindow(ImGuiWindow& a_Window);
+
+				/// <summary>
+				/// Initializes all values and behaviours associated with the ECS statistics window.
+				/// </summary>
+				/// <returns>True if initialization is successful, otherwise false.</returns>
+				bool Initialize() override;
+
+				/// <summary>
+				/// Renders the ECS statistics window.
+				/// </summary>
+				void Render() override;
+			private:
+				/// <summary>
+				/// Sorts the rows of the system table by the columns the user picked.
+				/// </summary>
+				/// <param name="a_SortSpecs">The sort specs of the table.</param>
+				void SortRows(const ImGuiTableSortSpecs& a_SortSpecs);
+
+				gameplay::ECSStats m_Stats; /// Stats of the last frame, kept to reuse the allocations.
+				std::vector<size_t> m_Rows; /// Indices into m_Stats.m_Systems, in display order.
+			};
+		}
+	}
+}
+
+#endif // _EDITOR
\ No newline at end of file
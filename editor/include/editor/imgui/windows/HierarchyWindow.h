@@ -8,6 +8,7 @@
 
 #include "editor/imgui/views/DataTypes/StringTextInput.h"
 #include "editor/imgui/views/Selectables/EntityUIView.h"
+#include "gameplay/ECSEvents.h"
 
 namespace gallus
 {
@@ -56,12 +57,23 @@ namespace gallus
 				/// Updates the components shown in the inspector window if applicable.
 				/// </summary>
 				void UpdateEntityComponents();
+
+				/// <summary>
+				/// Selects an entity as if it was clicked in the hierarchy. The search is cleared if it hides the entity.
+				/// </summary>
+				/// <param name="a_ID">The entity, an invalid id clears the selection.</param>
+				void SelectEntity(const gameplay::EntityID& a_ID);
 			private:
 				gameplay::EntityID m_LastID; /// The last ID that was selected in the hierarchy view.
 				bool m_NeedsRefresh = true; /// Whether the hierarchy needs to refresh the results shown in the hierarchy window.
 				std::vector<EntityUIView> m_FilteredEntities; /// List of entities shown in the hierarchy window.
 
 				SearchBarInput m_SearchBar; /// Search bar to filter specific entities in the hierarchy window.
+
+				gameplay::SubscriptionID m_EntityCreatedSubscription = 0;
+				gameplay::SubscriptionID m_EntityDestroyedSubscription = 0;
+				gameplay::SubscriptionID m_WorldRestoredSubscription = 0;
+				gameplay::SubscriptionID m_ComponentsChangedSubscription = 0;
 			};
 		}
 	}
@@ -39,6 +39,12 @@ namespace gallus
 				/// Renders the scene window.
 				/// </summary>
 				void Render() override;
+			private:
+				/// <summary>
+				/// Selects the entity whose bounds are hit first by a ray through a point of the scene.
+				/// </summary>
+				/// <param name="a_UV">The point as texture coordinate of the render texture.</param>
+				void PickEntity(const ImVec2& a_UV);
 			};
 		}
 	}
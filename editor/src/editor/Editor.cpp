@@ -102,9 +102,9 @@ namespace gallus
 			return m_Clipboard;
 		}
 
-		void Editor::SetClipboard(core::Data& a_Data)
+		void Editor::SetClipboard(core::Data&& a_Data)
 		{
-			m_Clipboard = a_Data;
+			m_Clipboard = std::move(a_Data);
 		}
 
 		bool Editor::InitializeThread()
@@ -142,7 +142,7 @@ namespace gallus
 
 			fs::path path = file::FileLoader::GetPath(file::FileLoader::GetAppDataPath().generic_string() + SETTINGS_FOLDER + std::string(SETTINGS_PATH));
 			file::FileLoader::CreateFolder(path.parent_path());
-			if (!file::FileLoader::SaveFile(path, core::Data(buffer.GetString(), buffer.GetSize())))
+			if (!file::FileLoader::SaveFile(path, core::DataView(buffer.GetString(), buffer.GetSize())))
 			{
 				LOGF(LOGSEVERITY_ERROR, "TODO", "Something went wrong when trying to save the editor settings: \"%s\".", path.generic_string().c_str());
 				return false;
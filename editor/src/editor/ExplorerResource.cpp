@@ -30,6 +30,19 @@ namespace gallus
 			return file::FileLoader::GetPath(a_Path.generic_string() + ".meta");
 		}
 
+		bool parseMetadata(const fs::path& a_MetadataPath, const core::Data& a_Data, rapidjson::Document& a_Document)
+		{
+			a_Document.Parse(a_Data.dataAs<char>(), a_Data.size());
+
+			if (a_Document.HasParseError())
+			{
+				LOGF(LOGSEVERITY_ERROR, "TODO", "Failed loading in meta file '%s'.", a_MetadataPath.generic_string().c_str());
+				return false;
+			}
+
+			return true;
+		}
+
 		bool loadMetadata(const fs::path a_Path, rapidjson::Document& a_Document)
 		{
 			core::DataStream data;
@@ -38,15 +51,17 @@ namespace gallus
 				return false;
 			}
 
-			a_Document.Parse(reinterpret_cast<char*>(data.data()), data.size());
+			return parseMetadata(getMetadataPath(a_Path), data, a_Document);
+		}
 
-			if (a_Document.HasParseError())
+		bool loadMetadata(file::FileIORequest& a_Request, rapidjson::Document& a_Document)
+		{
+			if (!a_Request.Wait())
 			{
-				LOGF(LOGSEVERITY_ERROR, "TODO", "Failed loading in meta file '%s'.", getMetadataPath(a_Path).c_str());
 				return false;
 			}
 
-			return true;
+			return parseMetadata(a_Request.GetPath(), a_Request.GetData(), a_Document);
 		}
 
 		bool saveMetadata(const rapidjson::Document& a_JsonFile, const fs::path& a_Path)
@@ -55,7 +70,7 @@ namespace gallus
 			rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
 			a_JsonFile.Accept(writer);
 
-			return file::FileLoader::SaveFile(getMetadataPath(a_Path), core::Data(buffer.GetString(), buffer.GetSize()));
+			return file::FileLoader::SaveFile(getMetadataPath(a_Path), core::DataView(buffer.GetString(), buffer.GetSize()));
 		}
 
 		ExplorerResource::~ExplorerResource()
@@ -116,6 +131,8 @@ namespace gallus
 				m_Resources.clear();
 
 				// Go through each file/folder and check their status.
+				std::vector<fs::directory_entry> entries;
+				std::vector<fs::path> metadataPaths;
 				fs::directory_iterator ds = fs::directory_iterator(m_Path, std::filesystem::directory_options::skip_permission_denied);
 				for (const auto& dirEntry : ds)
 				{
@@ -126,9 +143,29 @@ namespace gallus
 						continue;
 					}
 
+					// Files with an extension that is not recognized are ignored.
+					if (!fs::is_directory(dirEntry.path()))
+					{
+						if (WAT.find(dirEntry.path().extension().generic_string()) == WAT.end())
+						{
+							continue;
+						}
+						metadataPaths.push_back(getMetadataPath(dirEntry.path()));
+					}
+					entries.push_back(dirEntry);
+				}
+
+				// The metadata of all files is requested at once so the reads overlap instead of waiting on each other.
+				std::vector<std::shared_ptr<file::FileIORequest>> metadata = core::ENGINE.GetFileIOSystem().ReadBatch(metadataPaths, file::FileIOPriority::High);
+				size_t metadataIndex = 0;
+
+				for (const fs::directory_entry& dirEntry : entries)
+				{
 					// If it is not a directory, it is a file and needs to get past the meta checks.
 					if (!fs::is_directory(dirEntry.path()))
 					{
+						file::FileIORequest& metadataRequest = *metadata[metadataIndex++];
+
 						std::string extension = dirEntry.path().extension().generic_string();
 
 						// Get the extension. If the extension is not recognized, it will just be ignored.
@@ -143,7 +180,7 @@ namespace gallus
 						assets::AssetType assetType = it->second[0];
 
 						rapidjson::Document document;
-						bool hasMetadata = loadMetadata(dirEntry.path(), document);
+						bool hasMetadata = loadMetadata(metadataRequest, document);
 						if (hasMetadata)
 						{
 							int iAssetType = 0;
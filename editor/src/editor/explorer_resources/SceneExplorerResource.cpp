@@ -65,7 +65,7 @@ namespace gallus
 			rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
 			document.Accept(writer);
 
-			if (!file::FileLoader::SaveFile(m_Path, core::Data(buffer.GetString(), buffer.GetSize())))
+			if (!file::FileLoader::SaveFile(m_Path, core::DataView(buffer.GetString(), buffer.GetSize())))
 			{
 				LOGF(LOGSEVERITY_ERROR, "TODO", "Something went wrong when trying to save scene file \"%s\".", m_Path.generic_string().c_str());
 				return false;
@@ -76,13 +76,13 @@ namespace gallus
 		bool SceneExplorerResource::Load()
 		{
 			rapidjson::Document document;
-			core::DataStream data;
-			if (!file::FileLoader::LoadFile(m_Path, data))
+			file::MappedFile data;
+			if (!file::FileLoader::MapFile(m_Path, data, file::MAP_HINT_SEQUENTIAL))
 			{
 				return false;
 			}
 
-			document.Parse(reinterpret_cast<char*>(data.data()), data.size());
+			document.Parse(data.dataAs<char>(), data.size());
 
 			if (document.HasParseError())
 			{
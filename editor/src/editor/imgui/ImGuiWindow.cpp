@@ -32,7 +32,8 @@ namespace gallus
 				m_SceneWindow(*this),
 				m_ExplorerWindow(*this),
 				m_HierarchyWindow(*this),
-				m_InspectorWindow(*this)
+				m_InspectorWindow(*this),
+				m_ECSStatsWindow(*this)
 			{}
 
 			bool ImGuiWindow::Initialize()
@@ -60,6 +61,7 @@ namespace gallus
 				m_ExplorerWindow.Initialize();
 				m_HierarchyWindow.Initialize();
 				m_InspectorWindow.Initialize();
+				m_ECSStatsWindow.Initialize();
 				//m_LoadProjectWindow.Initialize();
 
 				m_PreviewTexture = nullptr; // Default texture.
@@ -75,6 +77,7 @@ namespace gallus
 				m_ExplorerWindow.Destroy();
 				m_HierarchyWindow.Destroy();
 				m_InspectorWindow.Destroy();
+				m_ECSStatsWindow.Destroy();
 				//m_LoadProjectWindow.Destroy();
 
 				ImGui_ImplDX12_Shutdown();
@@ -336,6 +339,11 @@ namespace gallus
 				return m_PreviewTexture;
 			}
 
+			HierarchyWindow& ImGuiWindow::GetHierarchyWindow()
+			{
+				return m_HierarchyWindow;
+			}
+
 			void ImGuiWindow::Render(std::shared_ptr<graphics::dx12::CommandList> a_CommandList)
 			{
 				if (!m_Ready)
@@ -369,6 +377,7 @@ namespace gallus
 				m_ExplorerWindow.Update();
 				m_HierarchyWindow.Update();
 				m_InspectorWindow.Update();
+				m_ECSStatsWindow.Update();
 
 				ImGui::PopFont();
 
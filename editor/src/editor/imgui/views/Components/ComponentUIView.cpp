@@ -44,17 +44,17 @@ namespace gallus
 						rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
 						document.Accept(writer);
 
-						core::Data data(buffer.GetString(), buffer.GetSize());
-						core::ENGINE.GetEditor().SetClipboard(data);
+						core::ENGINE.GetEditor().SetClipboard(core::Data(buffer.GetString(), buffer.GetSize()));
 					}
 					ImGui::SameLine();
 					if (ImGui::IconButton(ImGui::IMGUI_FORMAT_ID(font::ICON_PASTE, BUTTON_ID, string_extensions::StringToUpper(GetName()) + "_PASTE_HIERARCHY").c_str(), size, m_Window.GetIconFont()))
 					{
 						rapidjson::Document document;
 						document.SetObject();
-						core::Data data = core::ENGINE.GetEditor().GetClipboard();
-						document.Parse(reinterpret_cast<char*>(data.data()), data.size());
+						const core::Data& data = core::ENGINE.GetEditor().GetClipboard();
+						document.Parse(data.dataAs<char>(), data.size());
 						a_Component.Deserialize(document, document.GetAllocator());
+						MarkComponentChanged();
 					}
 					ImGui::SameLine();
 					if (ImGui::IconButton(ImGui::IMGUI_FORMAT_ID(font::ICON_DELETE, BUTTON_ID, string_extensions::StringToUpper(GetName()) + "_DELETE_HIERARCHY").c_str(), size, m_Window.GetIconFont()))
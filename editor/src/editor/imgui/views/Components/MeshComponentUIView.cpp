@@ -17,11 +17,13 @@ namespace gallus
 		{
 			void MeshComponentUIView::RenderInner()
 			{
+				gameplay::MeshComponent& component = *GetComponent();
+
 				ImGui::DisplayHeader(m_Window.GetBoldFont(), "Mesh");
 
 				ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
 				ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
-				ImGui::Text(m_Component.GetTexture() ? std::string(m_Component.GetTexture()->GetName().begin(), m_Component.GetTexture()->GetName().end()).c_str() : "None");
+				ImGui::Text(component.GetTexture() ? std::string(component.GetTexture()->GetName().begin(), component.GetTexture()->GetName().end()).c_str() : "None");
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
 
@@ -31,7 +33,7 @@ namespace gallus
 
 				ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
 				ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
-				ImGui::Text(m_Component.GetShader() ? std::string(m_Component.GetShader()->GetName().begin(), m_Component.GetShader()->GetName().end()).c_str() : "None");
+				ImGui::Text(component.GetShader() ? std::string(component.GetShader()->GetName().begin(), component.GetShader()->GetName().end()).c_str() : "None");
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
 
@@ -41,7 +43,7 @@ namespace gallus
 
 				ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
 				ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
-				ImGui::Text(m_Component.GetTexture() ? std::string(m_Component.GetTexture()->GetName().begin(), m_Component.GetTexture()->GetName().end()).c_str() : "None");
+				ImGui::Text(component.GetTexture() ? std::string(component.GetTexture()->GetName().begin(), component.GetTexture()->GetName().end()).c_str() : "None");
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
 
@@ -51,7 +53,7 @@ namespace gallus
 
 				ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
 				ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
-				ImGui::Text(m_Component.GetMaterial() ? std::string(m_Component.GetMaterial()->GetName().begin(), m_Component.GetMaterial()->GetName().end()).c_str() : "None");
+				ImGui::Text(component.GetMaterial() ? std::string(component.GetMaterial()->GetName().begin(), component.GetMaterial()->GetName().end()).c_str() : "None");
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
 			}
@@ -29,6 +29,7 @@ namespace gallus
 			void TransformComponentUIView::RenderInner()
 			{
 				float fontSize = m_Window.GetFontSize();
+				gameplay::TransformComponent& component = *GetComponent();
 
 				ImGui::DisplayHeader(m_Window.GetBoldFont(), "Position");
 				ImGui::Indent();
@@ -36,10 +37,11 @@ namespace gallus
 				ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 0);
 				ImGui::PushItemWidth(75);
 
-				m_PositionView.SetValue(m_Component.Transform().GetPosition());
+				m_PositionView.SetValue(component.Transform().GetPosition());
 				if (m_PositionView.Render("TRANSFORM_POSITION_INSPECTOR"))
 				{
-					m_Component.Transform().SetPosition(m_PositionView.GetValue());
+					component.Transform().SetPosition(m_PositionView.GetValue());
+					MarkComponentChanged();
 					core::ENGINE.GetEditor().SetDirty();
 				}
 
@@ -47,10 +49,11 @@ namespace gallus
 				ImGui::DisplayHeader(m_Window.GetBoldFont(), "Rotation");
 				ImGui::Indent();
 
-				m_RotationView.SetValue(m_Component.Transform().GetRotation());
+				m_RotationView.SetValue(component.Transform().GetRotation());
 				if (m_RotationView.Render("TRANSFORM_ROTATION_INSPECTOR"))
 				{
-					m_Component.Transform().SetRotation(m_RotationView.GetValue());
+					component.Transform().SetRotation(m_RotationView.GetValue());
+					MarkComponentChanged();
 					core::ENGINE.GetEditor().SetDirty();
 				}
 
@@ -58,10 +61,11 @@ namespace gallus
 				ImGui::DisplayHeader(m_Window.GetBoldFont(), "Scale");
 				ImGui::Indent();
 
-				m_ScaleView.SetValue(m_Component.Transform().GetScale());
+				m_ScaleView.SetValue(component.Transform().GetScale());
 				if (m_ScaleView.Render("TRANSFORM_SCALE_INSPECTOR"))
 				{
-					m_Component.Transform().SetScale(m_ScaleView.GetValue());
+					component.Transform().SetScale(m_ScaleView.GetValue());
+					MarkComponentChanged();
 					core::ENGINE.GetEditor().SetDirty();
 				}
 
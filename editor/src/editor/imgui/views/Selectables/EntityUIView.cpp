@@ -38,6 +38,12 @@ namespace gallus
 
 			void EntityUIView::Render(bool& a_Clicked, bool a_Selected)
 			{
+				// The entity may have been deleted before the hierarchy got refreshed.
+				if (!core::ENGINE.GetECS().IsEntityValid(m_EntityID))
+				{
+					return;
+				}
+
 				gameplay::EntityInfoComponent& detailComponent = core::ENGINE.GetECS().GetSystem<gameplay::EntityInfoSystem>().GetComponent(m_EntityID);
 
 				// Set the size of each child
@@ -125,6 +131,11 @@ namespace gallus
 
 			void EntityUIView::RenderSelectable()
 			{
+				if (!core::ENGINE.GetECS().IsEntityValid(m_EntityID))
+				{
+					return;
+				}
+
 				bool dirty = false;
 
 				gameplay::EntityInfoComponent& detailComponent = core::ENGINE.GetECS().GetSystem<gameplay::EntityInfoSystem>().GetComponent(m_EntityID);
@@ -165,7 +176,7 @@ namespace gallus
 				ImGui::PopStyleVar();
 				ImGui::PopStyleVar();
 
-				if (!m_EntityID.IsValid())
+				if (!core::ENGINE.GetECS().IsEntityValid(m_EntityID))
 				{
 					return;
 				}
@@ -246,13 +257,14 @@ namespace gallus
 			{
 				gameplay::EntityComponentSystem& ecs = core::ENGINE.GetECS();
 				gameplay::TransformSystem& transformSys = ecs.GetSystem<gameplay::TransformSystem>();
-				if (ecs.GetSystem<gameplay::TransformSystem>().ContainsID(m_EntityID))
+				if (transformSys.ContainsID(m_EntityID))
 				{
-					m_Components.push_back(new TransformComponentUIView(m_Window, m_EntityID, core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>().GetComponent(m_EntityID), core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>()));
+					m_Components.push_back(new TransformComponentUIView(m_Window, m_EntityID, transformSys));
 				}
-				if (ecs.GetSystem<gameplay::MeshSystem>().ContainsID(m_EntityID))
+				gameplay::MeshSystem& meshSys = ecs.GetSystem<gameplay::MeshSystem>();
+				if (meshSys.ContainsID(m_EntityID))
 				{
-					m_Components.push_back(new MeshComponentUIView(m_Window, m_EntityID, core::ENGINE.GetECS().GetSystem<gameplay::MeshSystem>().GetComponent(m_EntityID), core::ENGINE.GetECS().GetSystem<gameplay::MeshSystem>()));
+					m_Components.push_back(new MeshComponentUIView(m_Window, m_EntityID, meshSys));
 				}
 			}
 
@@ -0,0 +1,224 @@
+#ifdef _EDITOR
+
+#include "editor/imgui/windows/ECSStatsWindow.h"
+
+#include <imgui/imgui_helpers.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <string>
+
+#include "editor/imgui/ImGuiWindow.h"
+#include "editor/imgui/font_icon.h"
+#include "core/Engine.h"
+
+namespace gallus
+{
+	namespace editor
+	{
+		namespace imgui
+		{
+			enum ECSStatsColumn
+			{
+				ECSStatsColumn_System,
+				ECSStatsColumn_Components,
+				ECSStatsColumn_PeakComponents,
+				ECSStatsColumn_ComponentSize,
+				ECSStatsColumn_Slots,
+				ECSStatsColumn_Sparse,
+				ECSStatsColumn_Allocated,
+				ECSStatsColumn_Live,
+				ECSStatsColumn_PeakAllocated,
+				ECSStatsColumn_PendingDeletes,
+				ECSStatsColumn_Count
+			};
+
+			/// <summary>
+			/// Formats a number of bytes with the largest unit that keeps it above 1.
+			/// </summary>
+			/// <param name="a_Bytes">The number of bytes.</param>
+			/// <returns>The formatted string.</returns>
+			static std::string FormatBytes(size_t a_Bytes)
+			{
+				const char* units[] = { "B", "KB", "MB", "GB" };
+				double value = static_cast<double>(a_Bytes);
+				size_t unit = 0;
+				while (value >= 1024.0 && unit + 1 < std::size(units))
+				{
+					value /= 1024.0;
+					unit++;
+				}
+
+				char buffer[32];
+				snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f %s" : "%.1f %s", value, units[unit]);
+				return buffer;
+			}
+
+			/// <summary>
+			/// Retrieves the share of allocated bytes that do not hold a live component.
+			/// </summary>
+			/// <param name="a_Allocated">The allocated bytes.</param>
+			/// <param name="a_Live">The live bytes.</param>
+			/// <returns>The unused share in percent.</returns>
+			static float GetUnusedPercentage(size_t a_Allocated, size_t a_Live)
+			{
+				return a_Allocated == 0 ? 0.0f : 100.0f * static_cast<float>(a_Allocated - std::min(a_Live, a_Allocated)) / static_cast<float>(a_Allocated);
+			}
+
+			ECSStatsWindow::ECSStatsWindow(ImGuiWindow& a_Window) : BaseWindow(a_Window, ImGuiWindowFlags_NoCollapse, std::string(font::ICON_GRID) + " ECS Statistics", "ECSStatistics")
+			{}
+
+			bool ECSStatsWindow::Initialize()
+			{
+				return BaseWindow::Initialize();
+			}
+
+			void ECSStatsWindow::Render()
+			{
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					core::ENGINE.GetECS().GetStats(m_Stats);
+				}
+
+				ImVec2 toolbarSize = ImVec2(ImGui::GetContentRegionAvail().x, m_Window.GetHeaderSize().y);
+				ImGui::BeginToolbar(toolbarSize);
+
+				if (ImGui::IconButton(
+					ImGui::IMGUI_FORMAT_ID(std::string(font::ICON_REFRESH), BUTTON_ID, "RESET_PEAKS_ECS_STATISTICS").c_str(), m_Window.GetHeaderSize(), m_Window.GetIconFont()))
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					core::ENGINE.GetECS().ResetPeakStats();
+				}
+				if (ImGui::IsItemHovered())
+				{
+					ImGui::SetTooltip("Reset peak values");
+				}
+
+				ImGui::EndToolbar(ImVec2(0, 0));
+
+				ImGui::Text("Entities: %zu (peak %zu, %zu indices)", m_Stats.m_EntityCount, m_Stats.m_PeakEntityCount, m_Stats.m_EntityIndexCount);
+				ImGui::Text("Memory: %s allocated, %s live (%.1f%% unused), entity tables %s",
+					FormatBytes(m_Stats.m_AllocatedBytes).c_str(),
+					FormatBytes(m_Stats.m_LiveBytes).c_str(),
+					GetUnusedPercentage(m_Stats.m_AllocatedBytes, m_Stats.m_LiveBytes),
+					FormatBytes(m_Stats.m_EntityTableBytes).c_str());
+				ImGui::Text("Pending: %zu creates, %zu destroys, %zu adds, %zu removes in %zu command buffers",
+					m_Stats.m_PendingCreates, m_Stats.m_PendingDestroys, m_Stats.m_PendingAdds, m_Stats.m_PendingRemoves, m_Stats.m_CommandBufferCount);
+				ImGui::Text("Handles: %zu reserved, %zu recycled", m_Stats.m_ReservedHandles, m_Stats.m_ReservableHandles);
+				ImGui::Text("Spatial index: %zu entities, height %zu, %s", m_Stats.m_SpatialIndexCount, m_Stats.m_SpatialIndexHeight, FormatBytes(m_Stats.m_SpatialIndexBytes).c_str());
+
+				const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+				if (!ImGui::BeginTable(ImGui::IMGUI_FORMAT_ID("", CHILD_ID, "SYSTEMS_ECS_STATISTICS").c_str(), ECSStatsColumn_Count, flags, ImGui::GetContentRegionAvail()))
+				{
+					return;
+				}
+
+				ImGui::TableSetupScrollFreeze(1, 1);
+				ImGui::TableSetupColumn("System", ImGuiTableColumnFlags_NoHide);
+				ImGui::TableSetupColumn("Components", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Peak", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Slots", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Sparse", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Allocated", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Live", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Peak allocated", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableSetupColumn("Pending deletes", ImGuiTableColumnFlags_PreferSortDescending);
+				ImGui::TableHeadersRow();
+
+				// The values change every frame, so the rows are sorted every frame and not only when the specs change.
+				m_Rows.resize(m_Stats.m_Systems.size());
+				std::iota(m_Rows.begin(), m_Rows.end(), 0);
+				if (const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs())
+				{
+					SortRows(*sortSpecs);
+				}
+
+				for (size_t row : m_Rows)
+				{
+					const gameplay::SystemStats& stats = m_Stats.m_Systems[row];
+					ImGui::TableNextRow();
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%s%s", stats.m_Name.empty() ? "(unnamed)" : stats.m_Name.c_str(), stats.m_Multiple ? " (multi)" : "");
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", stats.m_ComponentCount);
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", stats.m_PeakComponentCount);
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", FormatBytes(stats.m_ComponentSize).c_str());
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu / %zu", stats.m_SlotCount, stats.m_Capacity);
+					if (ImGui::IsItemHovered())
+					{
+						ImGui::SetTooltip("%zu gaps, %zu unused slots", stats.m_SlotCount - stats.m_ComponentCount, stats.m_Capacity - stats.m_SlotCount);
+					}
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", stats.m_SparseSize);
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", FormatBytes(stats.m_AllocatedBytes).c_str());
+					ImGui::TableNextColumn();
+					ImGui::Text("%s (%.1f%% unused)", FormatBytes(stats.m_LiveBytes).c_str(), GetUnusedPercentage(stats.m_AllocatedBytes, stats.m_LiveBytes));
+					ImGui::TableNextColumn();
+					ImGui::Text("%s", FormatBytes(stats.m_PeakAllocatedBytes).c_str());
+					ImGui::TableNextColumn();
+					ImGui::Text("%zu", stats.m_PendingDeletes);
+				}
+
+				ImGui::EndTable();
+			}
+
+			void ECSStatsWindow::SortRows(const ImGuiTableSortSpecs& a_SortSpecs)
+			{
+				auto getValue = [](const gameplay::SystemStats& a_Stats, ImS16 a_Column) -> size_t
+				{
+					switch (a_Column)
+					{
+						case ECSStatsColumn_Components: return a_Stats.m_ComponentCount;
+						case ECSStatsColumn_PeakComponents: return a_Stats.m_PeakComponentCount;
+						case ECSStatsColumn_ComponentSize: return a_Stats.m_ComponentSize;
+						case ECSStatsColumn_Slots: return a_Stats.m_SlotCount;
+						case ECSStatsColumn_Sparse: return a_Stats.m_SparseSize;
+						case ECSStatsColumn_Allocated: return a_Stats.m_AllocatedBytes;
+						case ECSStatsColumn_Live: return a_Stats.m_LiveBytes;
+						case ECSStatsColumn_PeakAllocated: return a_Stats.m_PeakAllocatedBytes;
+						case ECSStatsColumn_PendingDeletes: return a_Stats.m_PendingDeletes;
+						default: return 0;
+					}
+				};
+
+				std::stable_sort(m_Rows.begin(), m_Rows.end(), [this, &a_SortSpecs, &getValue](size_t a_Lhs, size_t a_Rhs)
+				{
+					const gameplay::SystemStats& lhs = m_Stats.m_Systems[a_Lhs];
+					const gameplay::SystemStats& rhs = m_Stats.m_Systems[a_Rhs];
+					for (int i = 0; i < a_SortSpecs.SpecsCount; i++)
+					{
+						const ImGuiTableColumnSortSpecs& spec = a_SortSpecs.Specs[i];
+						int order = 0;
+						if (spec.ColumnIndex == ECSStatsColumn_System)
+						{
+							order = lhs.m_Name.compare(rhs.m_Name);
+						}
+						else
+						{
+							const size_t left = getValue(lhs, spec.ColumnIndex);
+							const size_t right = getValue(rhs, spec.ColumnIndex);
+							order = left < right ? -1 : (left > right ? 1 : 0);
+						}
+
+						if (order != 0)
+						{
+							return spec.SortDirection == ImGuiSortDirection_Ascending ? order < 0 : order > 0;
+						}
+					}
+					return false;
+				});
+			}
+		}
+	}
+}
+
+#endif // _EDITOR
\ No newline at end of file
@@ -29,15 +29,51 @@ namespace gallus
 
 			bool HierarchyWindow::Initialize()
 			{
-				core::ENGINE.GetECS().m_OnEntitiesUpdated += std::bind(&HierarchyWindow::UpdateEntities, this);
-				core::ENGINE.GetECS().m_OnEntityComponentsUpdated += std::bind(&HierarchyWindow::UpdateEntityComponents, this);
+				std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+
+				gameplay::ECSEventBus& events = core::ENGINE.GetECS().GetEvents();
+				m_EntityCreatedSubscription = events.Get<gameplay::EntityCreatedEvent>().Subscribe([this](std::span<const gameplay::EntityCreatedEvent>)
+				{
+					UpdateEntities();
+				});
+				m_EntityDestroyedSubscription = events.Get<gameplay::EntityDestroyedEvent>().Subscribe([this](std::span<const gameplay::EntityDestroyedEvent>)
+				{
+					UpdateEntities();
+				});
+				m_WorldRestoredSubscription = events.Get<gameplay::WorldRestoredEvent>().Subscribe([this](std::span<const gameplay::WorldRestoredEvent>)
+				{
+					UpdateEntities();
+					UpdateEntityComponents();
+				});
+				m_ComponentsChangedSubscription = events.Get<gameplay::EntityComponentsChangedEvent>().Subscribe([this](std::span<const gameplay::EntityComponentsChangedEvent> a_Events)
+				{
+					// Only the inspector of the selected entity has to be rebuilt.
+					EntityUIView* selected = dynamic_cast<EntityUIView*>(core::ENGINE.GetEditor().GetSelectable());
+					if (!selected)
+					{
+						return;
+					}
+					for (const gameplay::EntityComponentsChangedEvent& event : a_Events)
+					{
+						if (event.m_ID == selected->GetEntityID())
+						{
+							UpdateEntityComponents();
+							return;
+						}
+					}
+				});
 				return BaseWindow::Initialize();
 			}
 
 			bool HierarchyWindow::Destroy()
 			{
-				core::ENGINE.GetECS().m_OnEntitiesUpdated -= std::bind(&HierarchyWindow::UpdateEntities, this);
-				core::ENGINE.GetECS().m_OnEntityComponentsUpdated -= std::bind(&HierarchyWindow::UpdateEntityComponents, this);
+				std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+
+				gameplay::ECSEventBus& events = core::ENGINE.GetECS().GetEvents();
+				events.Get<gameplay::EntityCreatedEvent>().Unsubscribe(m_EntityCreatedSubscription);
+				events.Get<gameplay::EntityDestroyedEvent>().Unsubscribe(m_EntityDestroyedSubscription);
+				events.Get<gameplay::WorldRestoredEvent>().Unsubscribe(m_WorldRestoredSubscription);
+				events.Get<gameplay::EntityComponentsChangedEvent>().Unsubscribe(m_ComponentsChangedSubscription);
 				return BaseWindow::Destroy();
 			}
 
@@ -178,6 +214,32 @@ namespace gallus
 				m_NeedsRefresh = true;
 			}
 
+			void HierarchyWindow::SelectEntity(const gameplay::EntityID& a_ID)
+			{
+				m_LastID = a_ID;
+				if (!a_ID.IsValid())
+				{
+					if (dynamic_cast<EntityUIView*>(core::ENGINE.GetEditor().GetSelectable()))
+					{
+						core::ENGINE.GetEditor().SetSelectable(nullptr);
+					}
+					return;
+				}
+
+				for (EntityUIView& entityView : m_FilteredEntities)
+				{
+					if (entityView.GetEntityID() == a_ID)
+					{
+						core::ENGINE.GetEditor().SetSelectable(&entityView);
+						return;
+					}
+				}
+
+				// The refresh selects m_LastID once the entity is in the list.
+				m_SearchBar.SetString("");
+				m_NeedsRefresh = true;
+			}
+
 			void HierarchyWindow::UpdateEntityComponents()
 			{
 				if (EntityUIView* derivedPtr = dynamic_cast<EntityUIView*>(core::ENGINE.GetEditor().GetSelectable()))
@@ -10,6 +10,7 @@
 #include "core/Engine.h"
 #include "graphics/dx12/Texture.h"
 #include "gameplay/systems/TransformSystem.h"
+#include "gameplay/SpatialIndex.h"
 
 namespace gallus
 {
@@ -33,17 +34,25 @@ namespace gallus
 
 				ImGui::SetCursorPosX(x);
 
-				//bool m_Started = core::ENGINE.GetECS().HasStarted(), m_Paused = core::ENGINE.GetECS().IsPaused();
-				//if (ImGui::TransparentCheckboxButton(IMGUI_FORMAT_ID(font::ICON_PLAY, BUTTON_ID, "PLAYSTOP_SCENE").c_str(), &m_Started, ImVec2(toolbarSize.y, toolbarSize.y)))
-				//{
-				//	core::ENGINE.GetECS().SetStarted(m_Started);
-				//}
-				//ImGui::SameLine();
+				// Starting saves the edit-time world, stopping restores it. The ECS reads these flags on the main thread.
+				bool started = false, paused = false;
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					started = core::ENGINE.GetECS().HasStarted();
+					paused = core::ENGINE.GetECS().IsPaused();
+				}
+				if (ImGui::IconCheckboxButton(ImGui::IMGUI_FORMAT_ID(font::ICON_PLAY, BUTTON_ID, "PLAYSTOP_SCENE").c_str(), &started, ImVec2(toolbarSize.y, toolbarSize.y), m_Window.GetIconFont()))
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					core::ENGINE.GetECS().SetStarted(started);
+				}
+				ImGui::SameLine();
 
-				//if (ImGui::TransparentCheckboxButton(IMGUI_FORMAT_ID(font::ICON_PAUSE, BUTTON_ID, "PAUSE_SCENE").c_str(), &m_Paused, ImVec2(toolbarSize.y, toolbarSize.y)))
-				//{
-				//	core::ENGINE.GetECS().SetPaused(m_Paused);
-				//}
+				if (ImGui::IconCheckboxButton(ImGui::IMGUI_FORMAT_ID(font::ICON_PAUSE, BUTTON_ID, "PAUSE_SCENE").c_str(), &paused, ImVec2(toolbarSize.y, toolbarSize.y), m_Window.GetIconFont()))
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					core::ENGINE.GetECS().SetPaused(paused);
+				}
 
 				ImGui::EndToolbar(ImVec2(ImGui::GetStyle().ItemSpacing.x, 0));
 
@@ -79,6 +88,16 @@ namespace gallus
 				ImGui::Image((ImTextureID) core::ENGINE.GetDX12().GetRenderTexture()->GetGPUHandle().ptr,
 					availableSize, uv0, uv1);
 
+				// Clicks on the gizmo manipulate the selected entity, clicks anywhere else pick the entity under the mouse.
+				if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsOver() && !ImGuizmo::IsUsing())
+				{
+					const ImVec2 imageMin = ImGui::GetItemRectMin();
+					const ImVec2 mousePos = ImGui::GetMousePos();
+					PickEntity(ImVec2(
+						uv0.x + (mousePos.x - imageMin.x) / availableSize.x * (uv1.x - uv0.x),
+						uv0.y + (mousePos.y - imageMin.y) / availableSize.y * (uv1.y - uv0.y)));
+				}
+
 				ImGui::SetCursorPos(ImVec2(initialPos.x, initialPos.y + toolbarSize.y));
 
 				EntityUIView* entity = dynamic_cast<EntityUIView*>(core::ENGINE.GetEditor().GetSelectable());
@@ -89,7 +108,7 @@ namespace gallus
 						return;
 					}
 
-					auto transformComponent = core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>().GetComponent(entity->GetEntityID());
+					gameplay::TransformSystem& transformSystem = core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>();
 
 					ImGuizmo::Enable(true);
 					ImGuizmo::SetOrthographic(false); // Use perspective mode
@@ -100,7 +119,7 @@ namespace gallus
 					ImGuizmo::SetRect(windowPos.x + initialPos.x, windowPos.y + initialPos.y + toolbarSize.y, availableSize.x, availableSize.y);
 
 					// Get transformation matrices
-					DirectX::XMMATRIX objectMat = transformComponent.Transform().GetWorldMatrix();
+					DirectX::XMMATRIX objectMat = transformSystem.GetWorldMatrix(entity->GetEntityID());
 					DirectX::XMMATRIX viewMat = core::ENGINE.GetDX12().GetCamera()->GetViewMatrix();
 					DirectX::XMMATRIX projMat = core::ENGINE.GetDX12().GetCamera()->GetProjectionMatrix();
 
@@ -128,7 +147,7 @@ namespace gallus
 					{
 						TEST("Gizmo manipulated!");
 						objectMat = XMLoadFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(gizmoMatrix));
-						transformComponent.Transform().SetWorldMatrix(objectMat);
+						transformSystem.SetWorldMatrix(entity->GetEntityID(), objectMat);
 					}
 				}
 
@@ -141,6 +160,29 @@ namespace gallus
 				//ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - (ImGui::CalcTextSize(fpsValue.c_str()).x + m_Window.GetWindowPadding().x));
 				//ImGui::TextColored(ImVec4(1, 1, 0, 1), fpsValue.c_str());
 			}
+
+			void SceneWindow::PickEntity(const ImVec2& a_UV)
+			{
+				const DirectX::XMMATRIX viewMat = core::ENGINE.GetDX12().GetCamera()->GetViewMatrix();
+				const DirectX::XMMATRIX projMat = core::ENGINE.GetDX12().GetCamera()->GetProjectionMatrix();
+				const DirectX::XMMATRIX inverseViewProj = DirectX::XMMatrixInverse(nullptr, viewMat * projMat);
+
+				// Texture coordinates run down, clip space runs up. The ray runs from the near plane to the far plane.
+				const float x = a_UV.x * 2.0f - 1.0f;
+				const float y = 1.0f - a_UV.y * 2.0f;
+				DirectX::XMFLOAT3 nearPoint, farPoint;
+				DirectX::XMStoreFloat3(&nearPoint, DirectX::XMVector3TransformCoord(DirectX::XMVectorSet(x, y, 0.0f, 1.0f), inverseViewProj));
+				DirectX::XMStoreFloat3(&farPoint, DirectX::XMVector3TransformCoord(DirectX::XMVectorSet(x, y, 1.0f, 1.0f), inverseViewProj));
+
+				const gameplay::Ray ray = { nearPoint, DirectX::XMFLOAT3(farPoint.x - nearPoint.x, farPoint.y - nearPoint.y, farPoint.z - nearPoint.z) };
+				gameplay::RaycastHit hit;
+				bool found = false;
+				{
+					std::lock_guard<std::mutex> lock(core::ENGINE.GetECS().m_EntityMutex);
+					found = core::ENGINE.GetECS().GetSpatialIndex().RaycastClosest(ray, 1.0f, hit);
+				}
+				m_Window.GetHierarchyWindow().SelectEntity(found ? hit.m_ID : gameplay::EntityID());
+			}
 		}
 	}
 }
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "core/DataView.h"
+
 namespace gallus
 {
 	namespace core
@@ -42,6 +44,12 @@ namespace gallus
 			/// <param name="a_Rhs">The Data object to copy from.</param>
 			Data(const Data& a_Rhs);
 
+			/// <summary>
+			/// Move constructor. Takes over the memory of the other object, which is left empty.
+			/// </summary>
+			/// <param name="a_Rhs">The Data object to move from.</param>
+			Data(Data&& a_Rhs) noexcept;
+
 			/// <summary>
 			/// Destructor to free allocated memory.
 			/// </summary>
@@ -54,6 +62,13 @@ namespace gallus
 			/// <returns>A reference to the current instance.</returns>
 			Data& operator=(const Data& a_Other);
 
+			/// <summary>
+			/// Move assignment operator. Frees the current memory and takes over the memory of the other object, which is left empty.
+			/// </summary>
+			/// <param name="a_Other">The Data object to move from.</param>
+			/// <returns>A reference to the current instance.</returns>
+			Data& operator=(Data&& a_Other) noexcept;
+
 			/// <summary>
 			/// Retrieves the size of the stored data in bytes.
 			/// </summary>
@@ -92,6 +107,25 @@ namespace gallus
 				return reinterpret_cast<T*>(m_Data);
 			}
 
+			/// <summary>
+			/// Creates a view of part of the data without copying it.
+			/// </summary>
+			/// <param name="a_Offset">Offset of the part in bytes.</param>
+			/// <param name="a_Size">Size of the part in bytes, SIZE_MAX for everything after the offset.</param>
+			/// <returns>The view of the part, clamped to the data.</returns>
+			DataView Slice(size_t a_Offset, size_t a_Size = SIZE_MAX) const
+			{
+				return DataView(m_Data, m_Size).Slice(a_Offset, a_Size);
+			}
+
+			/// <summary>
+			/// Views the data without copying it. The view is only valid while this object keeps its memory.
+			/// </summary>
+			operator DataView() const
+			{
+				return DataView(m_Data, m_Size);
+			}
+
 			/// <summary>
 			/// Frees the allocated memory for the data.
 			/// </summary>
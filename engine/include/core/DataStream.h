@@ -59,6 +59,18 @@ namespace gallus
 			/// <param name="a_Rhs">The DataStream object to copy from.</param>
 			DataStream(const Data& a_Rhs);
 
+			/// <summary>
+			/// Move constructor.
+			/// </summary>
+			/// <param name="a_Rhs">The DataStream object to move from, left empty.</param>
+			DataStream(DataStream&& a_Rhs) noexcept;
+
+			/// <summary>
+			/// Constructs a DataStream object that takes over the memory of a Data object.
+			/// </summary>
+			/// <param name="a_Rhs">The Data object to move from, left empty.</param>
+			DataStream(Data&& a_Rhs) noexcept;
+
 			/// <summary>
 			/// Copy assignment operator.
 			/// </summary>
@@ -66,6 +78,13 @@ namespace gallus
 			/// <returns>A reference to the current instance.</returns>
 			DataStream& operator=(const DataStream& a_Other);
 
+			/// <summary>
+			/// Move assignment operator.
+			/// </summary>
+			/// <param name="a_Other">The DataStream object to move from, left empty.</param>
+			/// <returns>A reference to the current instance.</returns>
+			DataStream& operator=(DataStream&& a_Other) noexcept;
+
 			/// <summary>
 			/// Frees the allocated memory for the data.
 			/// </summary>
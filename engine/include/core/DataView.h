@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		/// <summary>
+		/// Non-owning view of raw data. The data has to outlive the view.
+		/// </summary>
+		class DataView
+		{
+		public:
+			DataView() = default;
+
+			/// <summary>
+			/// Constructs a view of the specified raw data and size.
+			/// </summary>
+			/// <param name="a_Data">Pointer to the raw data.</param>
+			/// <param name="a_Size">Size of the data in bytes.</param>
+			DataView(const void* a_Data, size_t a_Size) : m_Data(a_Data), m_Size(a_Data ? a_Size : 0)
+			{}
+
+			/// <summary>
+			/// Retrieves the size of the viewed data in bytes.
+			/// </summary>
+			/// <returns>The size of the data.</returns>
+			size_t size() const
+			{
+				return m_Size;
+			}
+
+			/// <summary>
+			/// Checks whether the view contains no data.
+			/// </summary>
+			/// <returns>True if empty, otherwise false.</returns>
+			bool empty() const
+			{
+				return m_Size == 0;
+			}
+
+			/// <summary>
+			/// Provides a raw pointer to the viewed data.
+			/// </summary>
+			/// <returns>A void pointer to the data.</returns>
+			const void* data() const
+			{
+				return m_Data;
+			}
+
+			/// <summary>
+			/// Provides a typed pointer to the viewed data.
+			/// </summary>
+			/// <typeparam name="T">The desired type of the pointer.</typeparam>
+			/// <returns>A pointer to the data cast to type T.</returns>
+			template <typename T>
+			const T* dataAs() const
+			{
+				return reinterpret_cast<const T*>(m_Data);
+			}
+
+			/// <summary>
+			/// Creates a view of part of the data. The range is clamped to the data, so slicing past the end results in a shorter or empty view.
+			/// </summary>
+			/// <param name="a_Offset">Offset of the part in bytes.</param>
+			/// <param name="a_Size">Size of the part in bytes, SIZE_MAX for everything after the offset.</param>
+			/// <returns>The view of the part.</returns>
+			DataView Slice(size_t a_Offset, size_t a_Size = SIZE_MAX) const
+			{
+				if (a_Offset >= m_Size)
+				{
+					return DataView();
+				}
+				const size_t remaining = m_Size - a_Offset;
+				return DataView(reinterpret_cast<const unsigned char*>(m_Data) + a_Offset, a_Size < remaining ? a_Size : remaining);
+			}
+
+			/// <summary>
+			/// Accesses the byte at the specified index.
+			/// </summary>
+			/// <param name="a_Index">The index of the byte to access.</param>
+			/// <returns>The byte at the specified index.</returns>
+			unsigned char operator [] (size_t a_Index) const { return reinterpret_cast<const unsigned char*>(m_Data)[a_Index]; }
+		private:
+			const void* m_Data = nullptr; /// Pointer to the viewed data.
+			size_t m_Size = 0;            /// Size of the viewed data in bytes.
+		};
+	}
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "core/System.h"
+#include "core/JobSystem.h"
+#include "core/FileIOSystem.h"
+#include "core/FrameScheduler.h"
 #include "graphics/dx12/DX12System.h"
 #include "graphics/win32/Window.h"
 #include "core/input/InputSystem.h"
@@ -57,6 +60,24 @@ namespace gallus
 			/// <returns>Reference to the ecs instance.</returns>
 			gameplay::EntityComponentSystem& GetECS();
 
+			/// <summary>
+			/// Retrieves the job system.
+			/// </summary>
+			/// <returns>Reference to the job system instance.</returns>
+			JobSystem& GetJobSystem();
+
+			/// <summary>
+			/// Retrieves the file I/O system.
+			/// </summary>
+			/// <returns>Reference to the file I/O system instance.</returns>
+			file::FileIOSystem& GetFileIOSystem();
+
+			/// <summary>
+			/// Retrieves the frame scheduler that paces the main loop.
+			/// </summary>
+			/// <returns>Reference to the frame scheduler instance.</returns>
+			FrameScheduler& GetFrameScheduler();
+
 #ifdef _EDITOR
 			editor::Editor& GetEditor();
 #endif // _EDITOR
@@ -64,6 +85,9 @@ namespace gallus
 			graphics::win32::Window m_Window;
 			graphics::dx12::DX12System m_DX12System;
 			input::InputSystem m_InputSystem;
+			JobSystem m_JobSystem;
+			file::FileIOSystem m_FileIOSystem;
+			FrameScheduler m_FrameScheduler;
 			gameplay::EntityComponentSystem m_ECS;
 #ifdef _EDITOR
 			editor::Editor m_Editor;
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "core/System.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "core/Data.h"
+
+namespace fs = std::filesystem;
+
+namespace gallus
+{
+	namespace file
+	{
+		/// <summary>
+		/// Order in which queued requests are executed. Requests with the same priority run in the order they were queued.
+		/// </summary>
+		enum class FileIOPriority
+		{
+			Low,
+			Normal,
+			High
+		};
+
+		enum class FileIOStatus
+		{
+			Queued,
+			Busy,
+			Done,
+			Failed,
+			Cancelled
+		};
+
+		class FileIORequest;
+
+		/// <summary>
+		/// Called once a request has finished, also when it failed or was cancelled. Runs on the thread that finished the request,
+		/// which is an I/O thread unless the request was cancelled or there are no I/O threads. Waiting threads are released after
+		/// the callback has returned.
+		/// </summary>
+		using FileIOCallback = std::function<void(FileIORequest&)>;
+
+		/// <summary>
+		/// A read or write that was queued on the file I/O system.
+		/// </summary>
+		class FileIORequest
+		{
+		public:
+			/// <summary>
+			/// Retrieves the status of the request.
+			/// </summary>
+			/// <returns>The status.</returns>
+			FileIOStatus GetStatus() const
+			{
+				return m_Status.load(std::memory_order_acquire);
+			}
+
+			/// <summary>
+			/// Checks whether the request has finished, whether it succeeded or not.
+			/// </summary>
+			/// <returns>True if the request is done, failed or cancelled, otherwise false.</returns>
+			bool IsFinished() const
+			{
+				return m_Finished.load(std::memory_order_acquire);
+			}
+
+			/// <summary>
+			/// Blocks until the request has finished.
+			/// </summary>
+			/// <returns>True if the request is done, otherwise false.</returns>
+			bool Wait() const
+			{
+				m_Finished.wait(false, std::memory_order_acquire);
+				return GetStatus() == FileIOStatus::Done;
+			}
+
+			/// <summary>
+			/// Retrieves the path of the file.
+			/// </summary>
+			/// <returns>The path.</returns>
+			const fs::path& GetPath() const
+			{
+				return m_Path;
+			}
+
+			/// <summary>
+			/// Retrieves the contents of the file for a read, or the data that was written for a write. Only safe to access once
+			/// the request has finished, the data can be moved out.
+			/// </summary>
+			/// <returns>Reference to the data.</returns>
+			core::Data& GetData()
+			{
+				return m_Data;
+			}
+		private:
+			friend class FileIOSystem;
+
+			fs::path m_Path;
+			std::string m_Key; /// Normalized path used to find requests for the same file.
+			core::Data m_Data;
+			FileIOCallback m_Callback;
+			FileIOPriority m_Priority = FileIOPriority::Normal;
+			uint64_t m_Sequence = 0; /// Order in which the request was queued.
+			bool m_Write = false;
+			std::atomic<FileIOStatus> m_Status{ FileIOStatus::Queued };
+			std::atomic<bool> m_Finished{ false }; /// Set once the callback has returned.
+		};
+
+		/// <summary>
+		/// Executes file reads and writes on a small pool of I/O threads so that the calling threads do not block on the disk.
+		/// Requests for the same file never run at the same time and run in the order they were queued, whatever their priority.
+		/// Queued reads of the same file are served by one read, queued writes of the same file only write the newest data.
+		/// </summary>
+		class FileIOSystem : public core::System
+		{
+		public:
+			/// <summary>
+			/// Initializes the file I/O system with the default amount of I/O threads.
+			/// </summary>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize() override;
+
+			/// <summary>
+			/// Initializes the file I/O system with a specific amount of I/O threads.
+			/// </summary>
+			/// <param name="a_ThreadCount">The amount of I/O threads. With 0 threads requests run on the calling thread.</param>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize(size_t a_ThreadCount);
+
+			/// <summary>
+			/// Stops and joins the I/O threads. Requests that have not started yet are cancelled.
+			/// </summary>
+			/// <returns>True if the destruction was successful, otherwise false.</returns>
+			bool Destroy() override;
+
+			/// <summary>
+			/// Queues a read of a whole file.
+			/// </summary>
+			/// <param name="a_Path">Path to the file.</param>
+			/// <param name="a_Priority">Priority of the request.</param>
+			/// <param name="a_Callback">Optional callback for when the request has finished.</param>
+			/// <returns>The request.</returns>
+			std::shared_ptr<FileIORequest> Read(const fs::path& a_Path, FileIOPriority a_Priority = FileIOPriority::Normal, FileIOCallback a_Callback = nullptr);
+
+			/// <summary>
+			/// Queues reads of multiple files at once. The reads are ordered by path so files of the same folder are read together.
+			/// </summary>
+			/// <param name="a_Paths">Paths to the files.</param>
+			/// <param name="a_Priority">Priority of the requests.</param>
+			/// <param name="a_Callback">Optional callback for when a request has finished, called for every request.</param>
+			/// <returns>The requests, in the same order as the paths.</returns>
+			std::vector<std::shared_ptr<FileIORequest>> ReadBatch(const std::vector<fs::path>& a_Paths, FileIOPriority a_Priority = FileIOPriority::Normal, FileIOCallback a_Callback = nullptr);
+
+			/// <summary>
+			/// Queues a write of a whole file.
+			/// </summary>
+			/// <param name="a_Path">Path to the file.</param>
+			/// <param name="a_Data">The data to write, moved into the request.</param>
+			/// <param name="a_Priority">Priority of the request.</param>
+			/// <param name="a_Callback">Optional callback for when the request has finished.</param>
+			/// <returns>The request.</returns>
+			std::shared_ptr<FileIORequest> Write(const fs::path& a_Path, core::Data&& a_Data, FileIOPriority a_Priority = FileIOPriority::Normal, FileIOCallback a_Callback = nullptr);
+
+			/// <summary>
+			/// Cancels a request that has not started yet. Its callback is called on the calling thread.
+			/// </summary>
+			/// <param name="a_Request">The request.</param>
+			/// <returns>True if the request was cancelled, false if it already started or finished.</returns>
+			bool Cancel(const std::shared_ptr<FileIORequest>& a_Request);
+
+			/// <summary>
+			/// Retrieves the amount of I/O threads.
+			/// </summary>
+			/// <returns>The amount of I/O threads.</returns>
+			size_t GetThreadCount() const;
+		private:
+			struct RequestOrder
+			{
+				bool operator()(const std::shared_ptr<FileIORequest>& a_Lhs, const std::shared_ptr<FileIORequest>& a_Rhs) const
+				{
+					return a_Lhs->m_Priority != a_Rhs->m_Priority ? a_Lhs->m_Priority > a_Rhs->m_Priority : a_Lhs->m_Sequence < a_Rhs->m_Sequence;
+				}
+			};
+
+			using RequestList = std::vector<std::shared_ptr<FileIORequest>>;
+
+			/// <summary>
+			/// Creates a request that has not been queued yet.
+			/// </summary>
+			std::shared_ptr<FileIORequest> CreateRequest(const fs::path& a_Path, bool a_Write, FileIOPriority a_Priority, FileIOCallback a_Callback) const;
+
+			/// <summary>
+			/// Queues requests, or executes them right away when there are no I/O threads.
+			/// </summary>
+			/// <param name="a_Requests">The requests, in the order they are queued.</param>
+			void Submit(const RequestList& a_Requests);
+
+			/// <summary>
+			/// Picks the file of the first queued request that is not busy and takes its oldest request, together with the requests
+			/// of the same kind queued directly after it. Expects the queue to be locked.
+			/// </summary>
+			/// <param name="a_Requests">The requests that were taken, the one to execute first.</param>
+			/// <returns>True if requests were taken, otherwise false.</returns>
+			bool TakeRequests(RequestList& a_Requests);
+
+			/// <summary>
+			/// Reads or writes the file of the requests and finishes all of them.
+			/// </summary>
+			/// <param name="a_Requests">Requests for the same file and operation, the one to execute first.</param>
+			void Execute(RequestList& a_Requests);
+
+			/// <summary>
+			/// Sets the final status of a request, calls its callback and wakes up anyone waiting on it.
+			/// </summary>
+			void Finish(FileIORequest& a_Request, FileIOStatus a_Status);
+
+			void ThreadLoop();
+
+			std::vector<std::thread> m_Threads; /// The I/O threads.
+			std::set<std::shared_ptr<FileIORequest>, RequestOrder> m_Queue; /// Queued requests, in the order they are executed.
+			std::unordered_set<std::string> m_BusyFiles; /// Files that are being read or written right now.
+			uint64_t m_NextSequence = 0;
+			std::mutex m_QueueMutex;
+			std::condition_variable m_QueueCondVar; /// Wakes up I/O threads when requests are queued, files are released or the system stops.
+			bool m_Running = false; /// Whether there are I/O threads taking requests.
+			bool m_Stop = false; /// Flag indicating whether the I/O threads need to stop.
+		};
+	}
+}
\ No newline at end of file
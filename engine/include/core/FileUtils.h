@@ -3,6 +3,8 @@
 #include <string>
 #include <filesystem>
 
+#include "core/DataView.h"
+
 namespace fs = std::filesystem;
 
 namespace gallus
@@ -13,12 +15,103 @@ namespace gallus
 	}
 	namespace file
 	{
+		/// <summary>
+		/// Access pattern hints for a mapped file. They only affect how the OS pages the file in.
+		/// </summary>
+		enum MapHint : uint8_t
+		{
+			MAP_HINT_NONE = 0,
+			MAP_HINT_SEQUENTIAL = 1 << 0, /// The file is read front to back once.
+			MAP_HINT_WILLNEED = 1 << 1, /// The whole file is read soon, start paging it in now.
+		};
+
+		/// <summary>
+		/// Read-only view of a file mapped into memory. The file is unmapped when the object is destroyed.
+		/// </summary>
+		class MappedFile
+		{
+		public:
+			MappedFile() = default;
+			MappedFile(const MappedFile&) = delete;
+			MappedFile(MappedFile&& a_Rhs) noexcept;
+			~MappedFile();
+
+			MappedFile& operator=(const MappedFile&) = delete;
+			MappedFile& operator=(MappedFile&& a_Other) noexcept;
+
+			/// <summary>
+			/// Retrieves the size of the mapped file in bytes.
+			/// </summary>
+			/// <returns>The size of the file.</returns>
+			size_t size() const
+			{
+				return m_Size;
+			}
+
+			/// <summary>
+			/// Checks whether nothing is mapped, either because nothing was mapped or because the file is empty.
+			/// </summary>
+			/// <returns>True if empty, otherwise false.</returns>
+			bool empty() const
+			{
+				return m_Size == 0;
+			}
+
+			/// <summary>
+			/// Provides a raw pointer to the mapped file.
+			/// </summary>
+			/// <returns>A pointer to the read-only contents.</returns>
+			const void* data() const
+			{
+				return m_Data;
+			}
+
+			/// <summary>
+			/// Provides a typed pointer to the mapped file.
+			/// </summary>
+			/// <typeparam name="T">The desired type of the pointer.</typeparam>
+			/// <returns>A pointer to the read-only contents cast to type T.</returns>
+			template <typename T>
+			const T* dataAs() const
+			{
+				return reinterpret_cast<const T*>(m_Data);
+			}
+
+			/// <summary>
+			/// Views the mapped file. The view is only valid while the file stays mapped.
+			/// </summary>
+			operator core::DataView() const
+			{
+				return core::DataView(m_Data, m_Size);
+			}
+
+			/// <summary>
+			/// Unmaps the file.
+			/// </summary>
+			void Unmap();
+		private:
+			friend class FileLoader;
+
+			const void* m_Data = nullptr; /// Start of the mapped view.
+			size_t m_Size = 0;            /// Size of the file in bytes.
+		};
+
 		class FileLoader
 		{
 		public:
 			static const fs::path GetAppDataPath();
 			static bool LoadFile(const fs::path& a_Path, core::DataStream& a_Data);
-			static bool SaveFile(const fs::path& a_Path, const core::DataStream& a_Data);
+
+			/// <summary>
+			/// Maps a file into memory read-only instead of reading it into a buffer. Pages are only loaded when they are touched
+			/// and can be dropped again by the OS, so large assets do not have to be copied into memory as a whole.
+			/// </summary>
+			/// <param name="a_Path">Path to the file.</param>
+			/// <param name="a_File">The mapped file. Anything it mapped before is unmapped.</param>
+			/// <param name="a_Hints">Combination of MapHint flags.</param>
+			/// <returns>True if the file was mapped or is empty, otherwise false.</returns>
+			static bool MapFile(const fs::path& a_Path, MappedFile& a_File, uint8_t a_Hints = MAP_HINT_NONE);
+			static bool SaveFile(const fs::path& a_Path, const core::DataView& a_Data);
 			static bool CreateFolder(const fs::path& a_Path);
 			static bool OpenInExplorer(const fs::path& a_Path);
 			static fs::path GetPath(const std::string& a_Path);
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/System.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		/// <summary>
+		/// Paces the main loop. Measures the time between frames, optionally splits it into fixed simulation steps
+		/// and sleeps until the next frame is due, so the loop does not keep a core busy.
+		/// Usage per frame: BeginFrame, then either update with GetDeltaTime or call StepFixed in a loop and update
+		/// with GetFixedTimeStep for every step, then WaitForNextFrame.
+		/// </summary>
+		class FrameScheduler : public System
+		{
+		public:
+			static constexpr double DEFAULT_FRAME_RATE = 60.0; /// Frame rate the loop is limited to by default.
+			static constexpr double MAX_DELTA_TIME = 0.25; /// Longer frames (breakpoints, window drags) are clamped to this.
+			static constexpr uint32_t MAX_FIXED_STEPS = 8; /// Fixed steps per frame before the remaining time is dropped.
+
+			/// <summary>
+			/// Starts measuring time from now.
+			/// </summary>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize() override;
+
+			/// <summary>
+			/// Releases the timer used for sleeping.
+			/// </summary>
+			/// <returns>True if the destruction was successful, otherwise false.</returns>
+			bool Destroy() override;
+
+			/// <summary>
+			/// Sets the frame rate the loop is limited to. Safe to call from any thread.
+			/// </summary>
+			/// <param name="a_FramesPerSecond">Frames per second, 0 to only yield between frames.</param>
+			void SetTargetFrameRate(double a_FramesPerSecond);
+			double GetTargetFrameRate() const;
+
+			/// <summary>
+			/// Sets the length of a fixed simulation step. Safe to call from any thread.
+			/// </summary>
+			/// <param name="a_Seconds">Length of a step in seconds, 0 to update once per frame with the measured delta time.</param>
+			void SetFixedTimeStep(double a_Seconds);
+
+			/// <summary>
+			/// Retrieves the length of a fixed simulation step.
+			/// </summary>
+			/// <returns>Length of a step in seconds, 0 if fixed steps are disabled.</returns>
+			float GetFixedTimeStep() const;
+
+			/// <summary>
+			/// Starts a frame: measures the time since the previous frame and adds it to the fixed step accumulator.
+			/// </summary>
+			void BeginFrame();
+
+			/// <summary>
+			/// Retrieves the measured time between the start of the previous frame and the start of this one.
+			/// </summary>
+			/// <returns>Delta time in seconds, clamped to MAX_DELTA_TIME.</returns>
+			float GetDeltaTime() const;
+
+			/// <summary>
+			/// Takes the next fixed step out of the accumulator.
+			/// </summary>
+			/// <returns>True if a step has to be simulated, false once the accumulated time is used up or fixed steps are disabled.</returns>
+			bool StepFixed();
+
+			/// <summary>
+			/// Retrieves how far the time is between the last simulated fixed step and the next one, for
+			/// interpolating between the last two simulated states. Safe to call from any thread.
+			/// </summary>
+			/// <returns>Value between 0 and 1, always 1 when fixed steps are disabled.</returns>
+			float GetInterpolationAlpha() const;
+
+			/// <summary>
+			/// Sleeps until the next frame is due according to the target frame rate.
+			/// </summary>
+			void WaitForNextFrame();
+
+			uint64_t GetFrameCount() const;
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			/// <summary>
+			/// Sleeps until a point in time. The OS sleep is woken up a little early and the rest is spent yielding,
+			/// because OS sleeps can overshoot by a scheduler tick.
+			/// </summary>
+			/// <param name="a_Deadline">The point in time to wake up at.</param>
+			void SleepUntil(Clock::time_point a_Deadline) const;
+
+			std::atomic<double> m_TargetFrameRate{ DEFAULT_FRAME_RATE };
+			std::atomic<double> m_FixedTimeStep{ 0.0 };
+			std::atomic<float> m_InterpolationAlpha{ 1.0f };
+
+			Clock::time_point m_FrameStart; /// Start of the current frame.
+			Clock::time_point m_NextFrame; /// When the next frame is due.
+			double m_DeltaTime = 0.0;
+			double m_Accumulator = 0.0; /// Time that has not been simulated in fixed steps yet.
+			uint32_t m_FixedSteps = 0; /// Fixed steps taken in the current frame.
+			uint64_t m_FrameCount = 0;
+			void* m_Timer = nullptr; /// High resolution waitable timer on Windows, nullptr if not available.
+		};
+	}
+}
\ No newline at end of file
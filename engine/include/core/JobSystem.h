@@ -0,0 +1,141 @@
+#pragma once
+
+#include "core/System.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gallus
+{
+	namespace core
+	{
+		/// <summary>
+		/// Tracks a set of jobs so that a caller can wait until all of them have finished.
+		/// </summary>
+		class JobGroup
+		{
+		public:
+			/// <summary>
+			/// Checks whether every job of the group has finished.
+			/// </summary>
+			/// <returns>True if no jobs are pending, otherwise false.</returns>
+			bool IsDone() const
+			{
+				return m_Pending.load(std::memory_order_acquire) == 0;
+			}
+		private:
+			friend class JobSystem;
+
+			std::atomic<uint32_t> m_Pending{ 0 }; /// Number of jobs that have not finished yet.
+		};
+
+		/// <summary>
+		/// Pool of worker threads that executes short jobs. Every worker has its own queue; jobs queued from a worker
+		/// go to its own queue and idle workers steal from the queues of the others. Threads that wait on a job group
+		/// help executing pending jobs instead of blocking.
+		/// </summary>
+		class JobSystem : public System
+		{
+		public:
+			/// <summary>
+			/// Initializes the job system with one worker for every hardware thread except the calling one.
+			/// </summary>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize() override;
+
+			/// <summary>
+			/// Initializes the job system with a specific amount of workers.
+			/// </summary>
+			/// <param name="a_WorkerCount">The amount of worker threads. With 0 workers jobs run on the calling thread.</param>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize(size_t a_WorkerCount);
+
+			/// <summary>
+			/// Stops and joins all worker threads. Jobs that have not started yet are discarded.
+			/// </summary>
+			/// <returns>True if the destruction was successful, otherwise false.</returns>
+			bool Destroy() override;
+
+			/// <summary>
+			/// Queues a job. When the job system has no workers the job runs immediately on the calling thread.
+			/// </summary>
+			/// <param name="a_Group">The group the job is part of.</param>
+			/// <param name="a_Job">The job.</param>
+			void Run(JobGroup& a_Group, std::function<void()> a_Job);
+
+			/// <summary>
+			/// Waits until all jobs of a group have finished, executing pending jobs in the meantime.
+			/// </summary>
+			/// <param name="a_Group">The group to wait for.</param>
+			void Wait(JobGroup& a_Group);
+
+			/// <summary>
+			/// Retrieves the amount of worker threads.
+			/// </summary>
+			/// <returns>The amount of worker threads.</returns>
+			size_t GetWorkerCount() const;
+		private:
+			struct Job
+			{
+				std::function<void()> m_Func;
+				JobGroup* m_Group = nullptr;
+			};
+
+			struct WorkerQueue
+			{
+				std::mutex m_Mutex;
+				std::deque<Job> m_Jobs;
+			};
+
+			/// <summary>
+			/// Takes a job from the queue of the calling worker or steals one from another queue, then executes it.
+			/// </summary>
+			/// <returns>True if a job was executed, otherwise false.</returns>
+			bool TryRunJob();
+
+			/// <summary>
+			/// Takes a job from the back of the worker's own queue.
+			/// </summary>
+			/// <param name="a_Queue">Index of the worker's queue.</param>
+			/// <param name="a_Job">The job that was taken.</param>
+			/// <returns>True if a job was taken, otherwise false.</returns>
+			bool PopJob(size_t a_Queue, Job& a_Job);
+
+			/// <summary>
+			/// Takes a job from the front of another queue, starting at the queue after a_Start.
+			/// </summary>
+			/// <param name="a_Start">Index of the queue to start searching after.</param>
+			/// <param name="a_Job">The job that was taken.</param>
+			/// <returns>True if a job was taken, otherwise false.</returns>
+			bool StealJob(size_t a_Start, Job& a_Job);
+
+			/// <summary>
+			/// Executes a job and marks it as finished in its group.
+			/// </summary>
+			/// <param name="a_Job">The job.</param>
+			void Execute(Job& a_Job);
+
+			/// <summary>
+			/// Retrieves the queue index of the calling thread.
+			/// </summary>
+			/// <returns>The queue index, or SIZE_MAX if the calling thread is not a worker of this job system.</returns>
+			size_t GetCurrentWorker() const;
+
+			void WorkerLoop(size_t a_Index);
+
+			std::vector<std::thread> m_Workers; /// The worker threads.
+			std::vector<std::unique_ptr<WorkerQueue>> m_Queues; /// One queue for every worker.
+			std::atomic<size_t> m_NextQueue{ 0 }; /// Round robin counter for jobs queued from other threads.
+			std::atomic<size_t> m_QueuedJobs{ 0 }; /// Number of jobs in all queues.
+			std::mutex m_SleepMutex; /// Used by idle workers to sleep.
+			std::condition_variable m_SleepCondVar; /// Wakes up workers when jobs are queued or the system stops.
+			std::atomic<bool> m_Stop{ false }; /// Flag indicating whether the workers need to stop.
+		};
+	}
+}
\ No newline at end of file
@@ -6,6 +6,10 @@ namespace gallus
 {
 	namespace core
 	{
+		/// <summary>
+		/// Data stream that grows while it is written to. The memory it reserves grows geometrically, so writing many small
+		/// values does not reallocate every time.
+		/// </summary>
 		class ReserveDataStream : public DataStream
 		{
 		public:
@@ -13,19 +17,50 @@ namespace gallus
 			ReserveDataStream(size_t a_Size);
 			ReserveDataStream(const ReserveDataStream& rhs);
 			ReserveDataStream(const DataStream& rhs);
+			ReserveDataStream(ReserveDataStream&& rhs) noexcept;
 
 			ReserveDataStream& operator=(const ReserveDataStream& a_Other);
+			ReserveDataStream& operator=(ReserveDataStream&& a_Other) noexcept;
 
 			void Free() override;
 
 			/// <summary>
-			/// Writes data to the data stream.
+			/// Writes data to the data stream, reserving more memory if it does not fit.
 			/// </summary>
 			bool Write(void const* a_Data, size_t a_Size) override;
 			bool Seek(size_t a_Offset, size_t a_Whence);
 			size_t Tell() const;
+
+			/// <summary>
+			/// Retrieves the amount of memory that is reserved, the amount of bytes that can be written without reallocating.
+			/// </summary>
+			/// <returns>The reserved size in bytes.</returns>
+			size_t capacity() const
+			{
+				return m_ReservedSize;
+			}
+
+			/// <summary>
+			/// Reserves memory up front, for when the size of what is going to be written is known. Never shrinks the stream.
+			/// </summary>
+			/// <param name="a_Capacity">The amount of bytes to reserve in total.</param>
+			/// <returns>True if the memory is reserved, false if the allocation failed.</returns>
+			bool Reserve(size_t a_Capacity);
+
+			/// <summary>
+			/// Releases the reserved memory that is not written to.
+			/// </summary>
+			void ShrinkToFit();
 		protected:
-			void Reallocate(size_t a_ExtraSize);
+			static constexpr size_t MIN_RESERVED_SIZE = 64; /// Smallest amount of memory reserved on the first write.
+
+			/// <summary>
+			/// Resizes the reserved memory, keeping what was written.
+			/// </summary>
+			/// <param name="a_ReservedSize">The new reserved size, at least the written size.</param>
+			/// <returns>True if the memory was resized, false if the allocation failed.</returns>
+			bool Reallocate(size_t a_ReservedSize);
+
 			size_t m_ReservedSize = 0;
 		};
 	}
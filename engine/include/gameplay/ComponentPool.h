@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Sparse-set storage for components of a single type. Components are kept in a densely packed array
+		/// with a sparse entity-to-slot table next to it, making add, remove and lookup constant time.
+		/// Every component carries the change tick of its last mutable access: non-const accessors stamp it,
+		/// const accessors and the raw arrays do not.
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component stored in the pool.</typeparam>
+		template <class ComponentType>
+		class ComponentPool
+		{
+		public:
+			static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+			/// <summary>
+			/// Checks whether the pool contains a component for the entity.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>True if the entity has a component in this pool, otherwise false.</returns>
+			bool Contains(const EntityID& a_ID) const
+			{
+				return GetSlot(a_ID) != INVALID_SLOT;
+			}
+
+			/// <summary>
+			/// Retrieves the dense slot of the entity's component.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>The slot, or INVALID_SLOT if the entity has no component in this pool.</returns>
+			uint32_t GetSlot(const EntityID& a_ID) const
+			{
+				const uint32_t index = a_ID.GetIndex();
+				if (index >= m_Sparse.size())
+				{
+					return INVALID_SLOT;
+				}
+
+				// The sparse table is indexed without the generation, so make sure the slot is not owned by an earlier occupant of the index.
+				const uint32_t slot = m_Sparse[index];
+				if (slot == INVALID_SLOT || m_Entities[slot] != a_ID)
+				{
+					return INVALID_SLOT;
+				}
+				return slot;
+			}
+
+			/// <summary>
+			/// Retrieves the component of the entity if it exists.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>Pointer to the component, or nullptr if the entity has no component in this pool.</returns>
+			ComponentType* TryGet(const EntityID& a_ID)
+			{
+				const uint32_t slot = GetSlot(a_ID);
+				return slot == INVALID_SLOT ? nullptr : &(*this)[slot];
+			}
+
+			const ComponentType* TryGet(const EntityID& a_ID) const
+			{
+				const uint32_t slot = GetSlot(a_ID);
+				return slot == INVALID_SLOT ? nullptr : &m_Components[slot];
+			}
+
+			/// <summary>
+			/// Retrieves the component of the entity. The entity must have a component in this pool.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>Reference to the component.</returns>
+			ComponentType& Get(const EntityID& a_ID)
+			{
+				return (*this)[m_Sparse[a_ID.GetIndex()]];
+			}
+
+			const ComponentType& Get(const EntityID& a_ID) const
+			{
+				return m_Components[m_Sparse[a_ID.GetIndex()]];
+			}
+
+			/// <summary>
+			/// Adds a default constructed component for the entity, or returns the existing one.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <returns>Reference to the component.</returns>
+			ComponentType& Emplace(const EntityID& a_ID)
+			{
+				const uint32_t index = a_ID.GetIndex();
+				if (index >= m_Sparse.size())
+				{
+					m_Sparse.resize(static_cast<size_t>(index) + 1, INVALID_SLOT);
+				}
+				else if (m_Sparse[index] != INVALID_SLOT)
+				{
+					// Indices are only recycled after all components of the previous occupant have been removed.
+					assert(m_Entities[m_Sparse[index]] == a_ID);
+					return (*this)[m_Sparse[index]];
+				}
+
+				// A new component counts as changed.
+				m_Sparse[index] = static_cast<uint32_t>(m_Components.size());
+				m_Entities.push_back(a_ID);
+				m_Versions.push_back(GetChangeTick());
+				return m_Components.emplace_back();
+			}
+
+			/// <summary>
+			/// Adds a copy of a component for every entity in the list, growing every array at most once.
+			/// Entities that already have a component keep it.
+			/// </summary>
+			/// <param name="a_IDs">The entities.</param>
+			/// <param name="a_Count">The number of entities.</param>
+			/// <param name="a_Component">The component to copy.</param>
+			/// <returns>The number of components that were added. They are the last ones in the dense array.</returns>
+			size_t Insert(const EntityID* a_IDs, size_t a_Count, const ComponentType& a_Component)
+			{
+				uint32_t maxIndex = 0;
+				for (size_t i = 0; i < a_Count; i++)
+				{
+					maxIndex = std::max(maxIndex, a_IDs[i].GetIndex());
+				}
+				if (a_Count > 0 && maxIndex >= m_Sparse.size())
+				{
+					m_Sparse.resize(static_cast<size_t>(maxIndex) + 1, INVALID_SLOT);
+				}
+
+				const size_t needed = m_Components.size() + a_Count;
+				if (needed > m_Components.capacity())
+				{
+					Reserve(std::max(needed, m_Components.capacity() * 2));
+				}
+
+				const size_t first = m_Components.size();
+				const uint32_t tick = GetChangeTick();
+				for (size_t i = 0; i < a_Count; i++)
+				{
+					const uint32_t index = a_IDs[i].GetIndex();
+					if (m_Sparse[index] != INVALID_SLOT)
+					{
+						assert(m_Entities[m_Sparse[index]] == a_IDs[i]);
+						continue;
+					}
+
+					m_Sparse[index] = static_cast<uint32_t>(m_Components.size());
+					m_Entities.push_back(a_IDs[i]);
+					m_Versions.push_back(tick);
+					m_Components.push_back(a_Component);
+				}
+				return m_Components.size() - first;
+			}
+
+			/// <summary>
+			/// Removes the component of the entity by moving the last component into its slot.
+			/// </summary>
+			/// <param name="a_ID">The entity whose component gets removed.</param>
+			/// <returns>True if a component was removed, otherwise false.</returns>
+			bool Remove(const EntityID& a_ID)
+			{
+				const uint32_t slot = GetSlot(a_ID);
+				if (slot == INVALID_SLOT)
+				{
+					return false;
+				}
+
+				const uint32_t last = static_cast<uint32_t>(m_Components.size() - 1);
+				if (slot != last)
+				{
+					m_Components[slot] = std::move(m_Components[last]);
+					m_Entities[slot] = m_Entities[last];
+					m_Versions[slot] = m_Versions[last];
+					m_Sparse[m_Entities[slot].GetIndex()] = slot;
+				}
+
+				m_Components.pop_back();
+				m_Entities.pop_back();
+				m_Versions.pop_back();
+				m_Sparse[a_ID.GetIndex()] = INVALID_SLOT;
+				return true;
+			}
+
+			/// <summary>
+			/// Reserves room for a number of components so that adding them does not reallocate.
+			/// </summary>
+			/// <param name="a_Size">The number of components to reserve room for.</param>
+			void Reserve(size_t a_Size)
+			{
+				m_Components.reserve(a_Size);
+				m_Entities.reserve(a_Size);
+				m_Versions.reserve(a_Size);
+			}
+
+			/// <summary>
+			/// Replaces the contents of the pool with a copy of another pool. Trivially copyable components are copied
+			/// with a single memcpy, others are copy constructed. The change tick source is not copied.
+			/// </summary>
+			/// <param name="a_Other">The pool to copy.</param>
+			void CopyFrom(const ComponentPool& a_Other)
+			{
+				if constexpr (std::is_trivially_copyable_v<ComponentType>)
+				{
+					m_Components.resize(a_Other.m_Components.size());
+					if (!m_Components.empty())
+					{
+						memcpy(m_Components.data(), a_Other.m_Components.data(), sizeof(ComponentType) * m_Components.size());
+					}
+				}
+				else
+				{
+					m_Components = a_Other.m_Components;
+				}
+				m_Entities = a_Other.m_Entities;
+				m_Versions = a_Other.m_Versions;
+				m_Sparse = a_Other.m_Sparse;
+			}
+
+			/// <summary>
+			/// Marks every component as changed.
+			/// </summary>
+			void MarkAllChanged()
+			{
+				std::fill(m_Versions.begin(), m_Versions.end(), GetChangeTick());
+			}
+
+			/// <summary>
+			/// Removes all components from the pool.
+			/// </summary>
+			void Clear()
+			{
+				m_Components.clear();
+				m_Entities.clear();
+				m_Versions.clear();
+				m_Sparse.clear();
+			}
+
+			size_t size() const
+			{
+				return m_Components.size();
+			}
+
+			bool empty() const
+			{
+				return m_Components.empty();
+			}
+
+			/// <summary>
+			/// Retrieves the entity that owns the component in a dense slot.
+			/// </summary>
+			/// <param name="a_Slot">The dense slot.</param>
+			/// <returns>The owning entity.</returns>
+			const EntityID& GetEntity(size_t a_Slot) const
+			{
+				return m_Entities[a_Slot];
+			}
+
+			/// <summary>
+			/// Retrieves the owning entities, packed in the same order as the components.
+			/// </summary>
+			/// <returns>Reference to the dense entity array.</returns>
+			const std::vector<EntityID>& GetEntities() const
+			{
+				return m_Entities;
+			}
+
+			/// <summary>
+			/// Retrieves the number of components the pool can hold without reallocating.
+			/// </summary>
+			/// <returns>The capacity of the dense arrays.</returns>
+			size_t GetCapacity() const
+			{
+				return m_Components.capacity();
+			}
+
+			/// <summary>
+			/// Retrieves the size of the sparse entity-to-slot table, which grows with the highest entity index that ever had a component.
+			/// </summary>
+			/// <returns>The number of entries.</returns>
+			size_t GetSparseSize() const
+			{
+				return m_Sparse.size();
+			}
+
+			/// <summary>
+			/// Retrieves the number of bytes allocated by the pool.
+			/// </summary>
+			/// <returns>The bytes allocated for the dense arrays and the sparse entity-to-slot table.</returns>
+			size_t GetAllocatedBytes() const
+			{
+				return m_Components.capacity() * sizeof(ComponentType) + m_Entities.capacity() * sizeof(EntityID) + m_Versions.capacity() * sizeof(uint32_t) + m_Sparse.capacity() * sizeof(uint32_t);
+			}
+
+			/// <summary>
+			/// Retrieves the number of bytes used by the components.
+			/// </summary>
+			/// <returns>The bytes of the dense entries that hold a component.</returns>
+			size_t GetLiveBytes() const
+			{
+				return size() * (sizeof(ComponentType) + sizeof(EntityID) + sizeof(uint32_t));
+			}
+
+			/// <summary>
+			/// Sets the counter the pool stamps changed components with.
+			/// </summary>
+			/// <param name="a_ChangeTick">The change tick counter, usually owned by the ECS.</param>
+			void SetChangeTickSource(const std::atomic<uint32_t>* a_ChangeTick)
+			{
+				m_ChangeTick = a_ChangeTick;
+			}
+
+			/// <summary>
+			/// Retrieves the tick changed components are stamped with right now.
+			/// </summary>
+			/// <returns>The current change tick.</returns>
+			uint32_t GetChangeTick() const
+			{
+				return m_ChangeTick ? m_ChangeTick->load(std::memory_order_relaxed) : 1;
+			}
+
+			/// <summary>
+			/// Retrieves the change tick of the last mutable access of a component.
+			/// </summary>
+			/// <param name="a_Slot">The dense slot.</param>
+			/// <returns>The change tick.</returns>
+			uint32_t GetVersion(size_t a_Slot) const
+			{
+				return m_Versions[a_Slot];
+			}
+
+			/// <summary>
+			/// Checks whether the component of an entity changed at or after a tick.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <param name="a_Since">The first tick that counts as a change.</param>
+			/// <returns>True if the entity has a component that changed since the tick, otherwise false.</returns>
+			bool HasChangedSince(const EntityID& a_ID, uint32_t a_Since) const
+			{
+				const uint32_t slot = GetSlot(a_ID);
+				return slot != INVALID_SLOT && m_Versions[slot] >= a_Since;
+			}
+
+			/// <summary>
+			/// Marks a component as changed, for code that modified it through a const path or the raw arrays.
+			/// </summary>
+			/// <param name="a_Slot">The dense slot.</param>
+			void MarkChanged(size_t a_Slot)
+			{
+				m_Versions[a_Slot] = GetChangeTick();
+			}
+
+			/// <summary>
+			/// Retrieves the densely packed components. Writes through this array are not tracked, call MarkChanged for those.
+			/// </summary>
+			/// <returns>Reference to the dense component array.</returns>
+			std::vector<ComponentType>& GetComponents()
+			{
+				return m_Components;
+			}
+
+			const std::vector<ComponentType>& GetComponents() const
+			{
+				return m_Components;
+			}
+
+			ComponentType& operator[](size_t a_Slot)
+			{
+				MarkChanged(a_Slot);
+				return m_Components[a_Slot];
+			}
+
+			const ComponentType& operator[](size_t a_Slot) const
+			{
+				return m_Components[a_Slot];
+			}
+		private:
+			std::vector<ComponentType> m_Components; /// Densely packed components.
+			std::vector<EntityID> m_Entities; /// Owner of each dense slot.
+			std::vector<uint32_t> m_Versions; /// Change tick of every dense slot.
+			std::vector<uint32_t> m_Sparse; /// Entity index to dense slot, INVALID_SLOT if absent.
+			const std::atomic<uint32_t>* m_ChangeTick = nullptr; /// Source of the change tick, 1 is used when not set.
+		};
+	}
+}
\ No newline at end of file
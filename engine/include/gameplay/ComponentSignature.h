@@ -0,0 +1,273 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+#include "gameplay/TypeIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		static constexpr size_t MAX_COMPONENT_TYPES = 128; /// Component and tag types together, every type takes one bit of a signature.
+
+		/// <summary>
+		/// Set of component types, one bit for every index of ComponentTypeIndex. Tag types are indexed by the same counter,
+		/// so a signature holds both the components and the tags of an entity.
+		/// </summary>
+		class ComponentSignature
+		{
+		public:
+			/// <summary>
+			/// Creates the signature of a list of types.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>The signature with a bit for every type.</returns>
+			template <class... Types>
+			static ComponentSignature Of()
+			{
+				ComponentSignature signature;
+				(signature.Set(ComponentTypeIndex::Get<Types>()), ...);
+				return signature;
+			}
+
+			/// <summary>
+			/// Checks whether every one of the types has a bit in a signature.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>True if all types fit, otherwise false.</returns>
+			template <class... Types>
+			static bool Fits()
+			{
+				return ((ComponentTypeIndex::Get<Types>() < MAX_COMPONENT_TYPES) && ...);
+			}
+
+			/// <summary>
+			/// Adds a type. Types past MAX_COMPONENT_TYPES have no bit and are not added.
+			/// </summary>
+			/// <param name="a_Type">Index of the type within ComponentTypeIndex.</param>
+			/// <returns>True if the type fits in the signature, otherwise false.</returns>
+			bool Set(size_t a_Type)
+			{
+				if (a_Type >= MAX_COMPONENT_TYPES)
+				{
+					return false;
+				}
+				m_Words[a_Type / WORD_BITS] |= uint64_t(1) << (a_Type % WORD_BITS);
+				return true;
+			}
+
+			void Reset(size_t a_Type)
+			{
+				if (a_Type < MAX_COMPONENT_TYPES)
+				{
+					m_Words[a_Type / WORD_BITS] &= ~(uint64_t(1) << (a_Type % WORD_BITS));
+				}
+			}
+
+			bool Test(size_t a_Type) const
+			{
+				return a_Type < MAX_COMPONENT_TYPES && (m_Words[a_Type / WORD_BITS] >> (a_Type % WORD_BITS)) & 1;
+			}
+
+			void Clear()
+			{
+				m_Words = {};
+			}
+
+			bool IsEmpty() const
+			{
+				uint64_t bits = 0;
+				for (uint64_t word : m_Words)
+				{
+					bits |= word;
+				}
+				return bits == 0;
+			}
+
+			/// <summary>
+			/// Adds every type of another signature.
+			/// </summary>
+			/// <param name="a_Other">The other signature.</param>
+			void Merge(const ComponentSignature& a_Other)
+			{
+				for (size_t i = 0; i < WORD_COUNT; i++)
+				{
+					m_Words[i] |= a_Other.m_Words[i];
+				}
+			}
+
+			/// <summary>
+			/// Checks whether the signature has every type of one signature and none of the types of another.
+			/// </summary>
+			/// <param name="a_Include">The types that are required.</param>
+			/// <param name="a_Exclude">The types that are not allowed.</param>
+			/// <returns>True if the signature matches, otherwise false.</returns>
+			bool Matches(const ComponentSignature& a_Include, const ComponentSignature& a_Exclude) const
+			{
+				// A missing required bit and a present excluded bit both leave a bit set, so one compare covers both.
+				uint64_t mismatch = 0;
+				for (size_t i = 0; i < WORD_COUNT; i++)
+				{
+					mismatch |= (a_Include.m_Words[i] & ~m_Words[i]) | (a_Exclude.m_Words[i] & m_Words[i]);
+				}
+				return mismatch == 0;
+			}
+
+			bool operator==(const ComponentSignature& a_Other) const
+			{
+				return m_Words == a_Other.m_Words;
+			}
+
+			bool operator!=(const ComponentSignature& a_Other) const
+			{
+				return !(*this == a_Other);
+			}
+		private:
+			static constexpr size_t WORD_BITS = 64;
+			static constexpr size_t WORD_COUNT = (MAX_COMPONENT_TYPES + WORD_BITS - 1) / WORD_BITS;
+
+			std::array<uint64_t, WORD_COUNT> m_Words = {};
+		};
+
+		/// <summary>
+		/// Include and exclude lists of component and tag types, tested against the signature of an entity.
+		/// </summary>
+		class SignatureFilter
+		{
+		public:
+			/// <summary>
+			/// Requires entities to have every one of the types.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>Reference to this filter.</returns>
+			template <class... Types>
+			SignatureFilter& With()
+			{
+				// A type without a bit can never be found in a signature, so nothing matches.
+				m_Unmatchable |= !ComponentSignature::Fits<Types...>();
+				m_Include.Merge(ComponentSignature::Of<Types...>());
+				return *this;
+			}
+
+			/// <summary>
+			/// Leaves out entities that have any of the types.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>Reference to this filter.</returns>
+			template <class... Types>
+			SignatureFilter& Without()
+			{
+				m_Exclude.Merge(ComponentSignature::Of<Types...>());
+				return *this;
+			}
+
+			bool Matches(const ComponentSignature& a_Signature) const
+			{
+				return !m_Unmatchable && a_Signature.Matches(m_Include, m_Exclude);
+			}
+
+			bool IsEmpty() const
+			{
+				return !m_Unmatchable && m_Include.IsEmpty() && m_Exclude.IsEmpty();
+			}
+		private:
+			ComponentSignature m_Include;
+			ComponentSignature m_Exclude;
+			bool m_Unmatchable = false; /// Set when a required type does not fit in a signature.
+		};
+
+		/// <summary>
+		/// The signature of every entity, indexed by entity index. The system that owns the pool of a component type
+		/// sets and clears its bit whenever the pool changes, the ECS sets and clears tags and empties the signature when
+		/// the entity is deleted. Same threading rules as structural changes.
+		/// </summary>
+		class EntitySignatures
+		{
+		public:
+			/// <summary>
+			/// Adds a type to the signature of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_Type">Index of the type within ComponentTypeIndex.</param>
+			/// <returns>True if the entity did not have the type yet, otherwise false. Always false for types that do not fit in a signature.</returns>
+			bool Add(const EntityID& a_ID, size_t a_Type)
+			{
+				if (a_Type >= MAX_COMPONENT_TYPES)
+				{
+					return false;
+				}
+				if (a_ID.GetIndex() >= m_Signatures.size())
+				{
+					m_Signatures.resize(static_cast<size_t>(a_ID.GetIndex()) + 1);
+				}
+				ComponentSignature& signature = m_Signatures[a_ID.GetIndex()];
+				if (signature.Test(a_Type))
+				{
+					return false;
+				}
+				signature.Set(a_Type);
+				return true;
+			}
+
+			/// <summary>
+			/// Removes a type from the signature of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_Type">Index of the type within ComponentTypeIndex.</param>
+			/// <returns>True if the entity had the type, otherwise false.</returns>
+			bool Remove(const EntityID& a_ID, size_t a_Type)
+			{
+				if (a_ID.GetIndex() >= m_Signatures.size() || !m_Signatures[a_ID.GetIndex()].Test(a_Type))
+				{
+					return false;
+				}
+				m_Signatures[a_ID.GetIndex()].Reset(a_Type);
+				return true;
+			}
+
+			/// <summary>
+			/// Removes every type from the signature of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			void ClearEntity(const EntityID& a_ID)
+			{
+				if (a_ID.GetIndex() < m_Signatures.size())
+				{
+					m_Signatures[a_ID.GetIndex()].Clear();
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the signature of an entity. The generation of the handle is not checked.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The signature, empty for indices that never had a component.</returns>
+			const ComponentSignature& Get(const EntityID& a_ID) const
+			{
+				return a_ID.GetIndex() < m_Signatures.size() ? m_Signatures[a_ID.GetIndex()] : EMPTY;
+			}
+
+			bool Matches(const EntityID& a_ID, const SignatureFilter& a_Filter) const
+			{
+				return a_Filter.Matches(Get(a_ID));
+			}
+
+			void Clear()
+			{
+				m_Signatures.clear();
+			}
+
+			size_t GetAllocatedBytes() const
+			{
+				return m_Signatures.capacity() * sizeof(ComponentSignature);
+			}
+		private:
+			inline static const ComponentSignature EMPTY;
+
+			std::vector<ComponentSignature> m_Signatures; /// Indexed by entity index.
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "gameplay/ComponentPool.h"
+#include "gameplay/ComponentSignature.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Joins several component pools and iterates over the entities that have all of the requested components.
+		/// Iteration is driven by the smallest pool, the other pools are only probed for the entities of that pool.
+		/// Entities can be filtered on further component and tag types, which is tested against the entity signature
+		/// before any pool is probed. Components requested as const are not marked as changed.
+		/// Components must not be added or removed while iterating.
+		/// </summary>
+		/// <typeparam name="ComponentTypes">The component types an entity needs to be part of the view.</typeparam>
+		template <class... ComponentTypes>
+		class ComponentView
+		{
+		public:
+			ComponentView(const EntitySignatures& a_Signatures, ComponentPool<std::remove_const_t<ComponentTypes>>*... a_Pools) : m_Signatures(a_Signatures), m_Pools(a_Pools...)
+			{}
+
+			/// <summary>
+			/// Only lets entities through that also have every one of the types.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>Reference to this view.</returns>
+			template <class... Types>
+			ComponentView& With()
+			{
+				m_Filter.With<Types...>();
+				return *this;
+			}
+
+			/// <summary>
+			/// Leaves out entities that have any of the types.
+			/// </summary>
+			/// <typeparam name="Types">The component or tag types.</typeparam>
+			/// <returns>Reference to this view.</returns>
+			template <class... Types>
+			ComponentView& Without()
+			{
+				m_Filter.Without<Types...>();
+				return *this;
+			}
+
+			/// <summary>
+			/// Only lets entities through whose component of the given type changed at or after a tick.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type to filter on, must be part of the view.</typeparam>
+			/// <param name="a_Since">The first change tick that counts, see EntityComponentSystem::AdvanceChangeTick.</param>
+			/// <returns>Reference to this view.</returns>
+			template <class ComponentType>
+			ComponentView& Changed(uint32_t a_Since)
+			{
+				static_assert(IndexOf<std::remove_const_t<ComponentType>>() < sizeof...(ComponentTypes), "ComponentType must be part of the view");
+				m_ChangedSince[IndexOf<std::remove_const_t<ComponentType>>()] = a_Since;
+				return *this;
+			}
+
+			/// <summary>
+			/// Calls the function for every entity that has all requested components.
+			/// </summary>
+			/// <param name="a_Func">Function with signature void(const EntityID&, ComponentTypes&...).</param>
+			template <class Func>
+			void ForEach(Func&& a_Func)
+			{
+				ForEach(std::index_sequence_for<ComponentTypes...>{}, a_Func);
+			}
+
+			/// <summary>
+			/// Retrieves the size of the smallest pool, which is the upper bound of entities in the view.
+			/// </summary>
+			/// <returns>The upper bound of entities in the view.</returns>
+			size_t SizeHint() const
+			{
+				return SizeHint(std::index_sequence_for<ComponentTypes...>{});
+			}
+		private:
+			template <class ComponentType>
+			static constexpr size_t IndexOf()
+			{
+				constexpr bool matches[] = { std::is_same_v<ComponentType, std::remove_const_t<ComponentTypes>>... };
+				for (size_t i = 0; i < sizeof...(ComponentTypes); i++)
+				{
+					if (matches[i])
+					{
+						return i;
+					}
+				}
+				return sizeof...(ComponentTypes);
+			}
+
+			template <size_t... Indices>
+			size_t SizeHint(std::index_sequence<Indices...>) const
+			{
+				if (((std::get<Indices>(m_Pools) == nullptr) || ...))
+				{
+					return 0;
+				}
+				return std::min({ std::get<Indices>(m_Pools)->size()... });
+			}
+
+			template <size_t... Indices, class Func>
+			void ForEach(std::index_sequence<Indices...>, Func& a_Func)
+			{
+				// A system that does not exist means no entity can be in the view.
+				if (((std::get<Indices>(m_Pools) == nullptr) || ...))
+				{
+					return;
+				}
+
+				const size_t sizes[] = { std::get<Indices>(m_Pools)->size()... };
+				const size_t driver = static_cast<size_t>(std::min_element(std::begin(sizes), std::end(sizes)) - std::begin(sizes));
+				((driver == Indices ? Iterate<Indices>(std::index_sequence<Indices...>{}, a_Func) : void()), ...);
+			}
+
+			template <size_t Driver, size_t... Indices, class Func>
+			void Iterate(std::index_sequence<Indices...>, Func& a_Func)
+			{
+				auto& driver = *std::get<Driver>(m_Pools);
+				const bool filtered = !m_Filter.IsEmpty();
+				for (size_t slot = 0; slot < driver.size(); slot++)
+				{
+					const EntityID& id = driver.GetEntity(slot);
+					if (filtered && !m_Signatures.Matches(id, m_Filter))
+					{
+						continue;
+					}
+
+					// Resolve every slot and check the change filters before touching a component, so filtered out
+					// entities are not marked as changed.
+					const std::array<uint32_t, sizeof...(ComponentTypes)> slots = { (Indices == Driver ? static_cast<uint32_t>(slot) : std::get<Indices>(m_Pools)->GetSlot(id))... };
+					if (((slots[Indices] == ComponentPool<std::remove_const_t<ComponentTypes>>::INVALID_SLOT) || ...))
+					{
+						continue;
+					}
+					if (((std::get<Indices>(m_Pools)->GetVersion(slots[Indices]) < m_ChangedSince[Indices]) || ...))
+					{
+						continue;
+					}
+					a_Func(id, Fetch<Indices>(slots[Indices])...);
+				}
+			}
+
+			template <size_t Index>
+			auto& Fetch(uint32_t a_Slot)
+			{
+				using ComponentType = std::tuple_element_t<Index, std::tuple<ComponentTypes...>>;
+				if constexpr (std::is_const_v<ComponentType>)
+				{
+					return std::as_const(*std::get<Index>(m_Pools))[a_Slot];
+				}
+				else
+				{
+					return (*std::get<Index>(m_Pools))[a_Slot];
+				}
+			}
+
+			const EntitySignatures& m_Signatures;
+			SignatureFilter m_Filter; /// Extra component and tag types to require or leave out.
+			std::tuple<ComponentPool<std::remove_const_t<ComponentTypes>>*...> m_Pools;
+			std::array<uint32_t, sizeof...(ComponentTypes)> m_ChangedSince = {}; /// Change filter per component type, 0 lets everything through.
+		};
+	}
+}
\ No newline at end of file
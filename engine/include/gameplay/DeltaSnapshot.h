@@ -0,0 +1,355 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+#include "gameplay/WorldSnapshot.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		class ReserveDataStream;
+	}
+	namespace gameplay
+	{
+		class EntityComponentSystem;
+		class AbstractECSSystem;
+
+		/*
+			Delta recording layout (little endian):
+			- DeltaHeader
+			- DeltaHeader::m_SystemCount system names of DELTA_NAME_SIZE bytes, in the order their blocks appear in every frame.
+			- One DeltaFrameHeader per frame followed by DeltaFrameHeader::m_Size bytes of bit packed payload.
+			A frame payload holds the destroyed entities and the created entities, each list ended by a 0 bit, followed by
+			one bit per system that tells whether the system wrote a block. A block is its size in bytes as varint and the
+			byte aligned block itself. Keyframes are deltas against an empty world, so every frame is decoded the same way.
+		*/
+
+		constexpr uint32_t DELTA_MAGIC = 0x544C4447; // "GDLT"
+		constexpr uint32_t DELTA_VERSION = 1;
+		constexpr size_t DELTA_NAME_SIZE = 32;
+		constexpr uint32_t DELTA_FRAME_KEYFRAME = 1 << 0;
+		constexpr uint32_t DELTA_DEFAULT_KEYFRAME_INTERVAL = 300;
+
+		struct DeltaHeader
+		{
+			uint32_t m_Magic = DELTA_MAGIC;
+			uint32_t m_Version = DELTA_VERSION;
+			uint32_t m_SystemCount = 0;
+			uint32_t m_KeyframeInterval = 0;
+		};
+
+		struct DeltaFrameHeader
+		{
+			uint32_t m_Size = 0; /// Size of the payload in bytes.
+			uint32_t m_Flags = 0; /// DELTA_FRAME_KEYFRAME for frames that do not depend on earlier frames.
+		};
+
+		/// <summary>
+		/// Converts a float to a multiple of 1 / a_StepsPerUnit. With a power of two step count, Dequantize(Quantize(x))
+		/// quantizes back to the same value, so values compared after quantizing never drift between encoder and decoder.
+		/// </summary>
+		/// <param name="a_Value">The value.</param>
+		/// <param name="a_StepsPerUnit">The number of steps per unit.</param>
+		/// <returns>The quantized value.</returns>
+		inline int64_t Quantize(float a_Value, float a_StepsPerUnit)
+		{
+			constexpr double LIMIT = 1ull << 52;
+			const double scaled = static_cast<double>(a_Value) * a_StepsPerUnit;
+			if (std::isnan(scaled))
+			{
+				return 0;
+			}
+			return std::llround(std::fmax(-LIMIT, std::fmin(LIMIT, scaled)));
+		}
+
+		inline float Dequantize(int64_t a_Value, float a_StepsPerUnit)
+		{
+			return static_cast<float>(static_cast<double>(a_Value) / a_StepsPerUnit);
+		}
+
+		/// <summary>
+		/// Packs values into a bit stream, least significant bit first. Used by systems in AbstractECSSystem::WriteDelta.
+		/// </summary>
+		class DeltaWriter
+		{
+		public:
+			/// <summary>
+			/// Spot in the stream that can be rewound to.
+			/// </summary>
+			struct Position
+			{
+				size_t m_BitCount = 0;
+				uint32_t m_LastIndex = 0;
+			};
+
+			/// <summary>
+			/// Writes the lowest bits of a value.
+			/// </summary>
+			/// <param name="a_Value">The value.</param>
+			/// <param name="a_Count">The number of bits, at most 64.</param>
+			void WriteBits(uint64_t a_Value, uint32_t a_Count);
+
+			void WriteBool(bool a_Value)
+			{
+				WriteBits(a_Value ? 1 : 0, 1);
+			}
+
+			/// <summary>
+			/// Writes an unsigned value in groups of 7 bits, so small values take few bits.
+			/// </summary>
+			/// <param name="a_Value">The value.</param>
+			void WriteVarint(uint64_t a_Value);
+
+			/// <summary>
+			/// Writes a signed value as a zigzag encoded varint, so small negative values take few bits as well.
+			/// </summary>
+			/// <param name="a_Value">The value.</param>
+			void WriteSignedVarint(int64_t a_Value);
+
+			/// <summary>
+			/// Writes an entity handle. The index is stored relative to the previous entity that was written, so entities
+			/// written in index order take a few bits each.
+			/// </summary>
+			/// <param name="a_ID">The entity, may be invalid.</param>
+			void WriteEntity(const EntityID& a_ID);
+
+			void WriteString(const std::string& a_Value);
+
+			/// <summary>
+			/// Writes raw bytes, starting at the next byte boundary.
+			/// </summary>
+			/// <param name="a_Data">The data.</param>
+			/// <param name="a_Size">The size in bytes.</param>
+			void WriteBytes(const void* a_Data, size_t a_Size);
+
+			/// <summary>
+			/// Pads the stream with zero bits up to the next byte boundary.
+			/// </summary>
+			void AlignToByte();
+
+			Position GetPosition() const
+			{
+				return { m_BitCount, m_LastIndex };
+			}
+
+			/// <summary>
+			/// Throws away everything written after a position.
+			/// </summary>
+			/// <param name="a_Position">A position retrieved from GetPosition.</param>
+			void Rewind(const Position& a_Position);
+
+			size_t GetBitCount() const
+			{
+				return m_BitCount;
+			}
+
+			/// <summary>
+			/// Retrieves the written bytes. The last byte is padded with zero bits.
+			/// </summary>
+			/// <returns>Reference to the bytes.</returns>
+			const std::vector<uint8_t>& GetData() const
+			{
+				return m_Data;
+			}
+
+			/// <summary>
+			/// Empties the stream, keeping its allocation.
+			/// </summary>
+			void Clear();
+		private:
+			std::vector<uint8_t> m_Data;
+			size_t m_BitCount = 0;
+			uint32_t m_LastIndex = 0; /// Index of the last entity that was written.
+		};
+
+		/// <summary>
+		/// Reads values from a bit stream written by DeltaWriter, straight from the recording memory. Reading past the end
+		/// returns zeroes and marks the reader as failed, so loops over 0 terminated lists always end.
+		/// Used by systems in AbstractECSSystem::ReadDelta.
+		/// </summary>
+		class DeltaReader
+		{
+		public:
+			DeltaReader(const unsigned char* a_Data, size_t a_Size) : m_Data(a_Data), m_BitSize(a_Size * 8)
+			{}
+
+			uint64_t ReadBits(uint32_t a_Count);
+
+			bool ReadBool()
+			{
+				return ReadBits(1) != 0;
+			}
+
+			uint64_t ReadVarint();
+			int64_t ReadSignedVarint();
+			EntityID ReadEntity();
+			std::string ReadString();
+
+			/// <summary>
+			/// Reads raw bytes without copying them, starting at the next byte boundary.
+			/// </summary>
+			/// <param name="a_Size">The size in bytes.</param>
+			/// <returns>Pointer to the data, or nullptr if the stream is too small.</returns>
+			const unsigned char* ReadBytes(size_t a_Size);
+
+			void AlignToByte();
+
+			/// <summary>
+			/// Checks whether a read went past the end of the stream or read invalid data.
+			/// </summary>
+			/// <returns>True if the data read so far can not be trusted, otherwise false.</returns>
+			bool HasFailed() const
+			{
+				return m_Failed;
+			}
+		private:
+			const unsigned char* m_Data = nullptr;
+			size_t m_BitSize = 0;
+			size_t m_BitPosition = 0;
+			uint32_t m_LastIndex = 0; /// Index of the last entity that was read.
+			bool m_Failed = false;
+		};
+
+		/// <summary>
+		/// Records the world every frame as the difference with the previous frame. Only entities that were created or
+		/// destroyed and components that were added, removed or changed are written, and of changed components only the
+		/// fields that differ. Every system that implements WriteDelta/ReadDelta gets a block. A keyframe is written every
+		/// so many frames, so a player does not have to decode the recording from the start to reach a frame.
+		/// Components that were not touched since the previous frame are skipped on their change tick, so the work per
+		/// frame mostly depends on what changed.
+		/// </summary>
+		class DeltaRecorder
+		{
+		public:
+			/// <summary>
+			/// Creates a recorder.
+			/// </summary>
+			/// <param name="a_KeyframeInterval">Number of frames from one keyframe to the next, 1 writes only keyframes.</param>
+			DeltaRecorder(uint32_t a_KeyframeInterval = DELTA_DEFAULT_KEYFRAME_INTERVAL);
+
+			/// <summary>
+			/// Appends the current state of the world to a recording. The first frame writes the recording header.
+			/// Must be called from the thread that updates the ECS or while holding m_EntityMutex, after the update, so
+			/// deleted entities are gone. Systems registered after the first frame are not recorded.
+			/// </summary>
+			/// <param name="a_ECS">The world to record.</param>
+			/// <param name="a_Stream">The stream the recording is written to, the same one for every frame.</param>
+			/// <returns>True if the frame was written, otherwise false.</returns>
+			bool RecordFrame(EntityComponentSystem& a_ECS, core::ReserveDataStream& a_Stream);
+
+			/// <summary>
+			/// Makes the next frame a keyframe.
+			/// </summary>
+			void RequestKeyframe()
+			{
+				m_KeyframeRequested = true;
+			}
+
+			/// <summary>
+			/// Forgets the previous frames, so the next frame starts a new recording with its own header.
+			/// </summary>
+			void Reset();
+
+			uint32_t GetFrameCount() const
+			{
+				return m_FrameCount;
+			}
+
+			/// <summary>
+			/// Retrieves the size of the last recorded frame, header included.
+			/// </summary>
+			/// <returns>The size in bytes.</returns>
+			size_t GetLastFrameSize() const
+			{
+				return m_LastFrameSize;
+			}
+		private:
+			void WriteEntities(EntityComponentSystem& a_ECS);
+
+			uint32_t m_KeyframeInterval = DELTA_DEFAULT_KEYFRAME_INTERVAL;
+			uint32_t m_FrameCount = 0;
+			uint32_t m_FramesSinceKeyframe = 0;
+			bool m_KeyframeRequested = false;
+			size_t m_SystemCount = 0; /// Number of systems that were registered when the recording started.
+			uint32_t m_ChangedSince = 0; /// First change tick that has not been recorded yet.
+			size_t m_LastFrameSize = 0;
+			std::vector<EntityID> m_Entities; /// Live entities as of the previous frame.
+			std::vector<uint32_t> m_Generations; /// Entity index to the generation that was alive in the previous frame, 0 if none.
+			std::vector<std::unique_ptr<AbstractComponentPoolCopy>> m_Baselines; /// Components of every system as of the previous frame.
+			DeltaWriter m_Writer;
+			DeltaWriter m_BlockWriter;
+		};
+
+		/// <summary>
+		/// Decodes frames of a recording made by DeltaRecorder into a WorldSnapshot, which EntityComponentSystem::RestoreWorld
+		/// can load. Going forward decodes the frames in between, any other frame is decoded from the keyframe before it.
+		/// Entities keep the handles they had while recording. Tags are not recorded.
+		/// </summary>
+		class DeltaPlayer
+		{
+		public:
+			static constexpr uint32_t NO_FRAME = UINT32_MAX;
+
+			/// <summary>
+			/// Indexes the frames of a recording. The recording is read in place and has to stay alive while the player is used.
+			/// </summary>
+			/// <param name="a_ECS">The world the frames will be restored into, it provides the systems that decode the blocks.</param>
+			/// <param name="a_Data">The recording.</param>
+			/// <param name="a_Size">The size of the recording in bytes.</param>
+			/// <returns>True if the recording was opened, otherwise false.</returns>
+			bool Open(EntityComponentSystem& a_ECS, const void* a_Data, size_t a_Size);
+
+			/// <summary>
+			/// Decodes a frame.
+			/// </summary>
+			/// <param name="a_Frame">The frame number, counting from the first recorded frame.</param>
+			/// <returns>True if the frame was decoded, otherwise false.</returns>
+			bool Seek(uint32_t a_Frame);
+
+			/// <summary>
+			/// Retrieves the world as of the last decoded frame.
+			/// </summary>
+			/// <returns>Reference to the world, not valid if no frame was decoded.</returns>
+			const WorldSnapshot& GetWorld() const
+			{
+				return m_World;
+			}
+
+			uint32_t GetFrameCount() const
+			{
+				return static_cast<uint32_t>(m_Frames.size());
+			}
+
+			uint32_t GetFrame() const
+			{
+				return m_Frame;
+			}
+		private:
+			static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+			struct Frame
+			{
+				size_t m_Offset = 0; /// Offset of the payload from the start of the recording.
+				uint32_t m_Size = 0;
+				bool m_Keyframe = false;
+			};
+
+			bool ApplyFrame(const Frame& a_Frame);
+			void DestroyEntity(const EntityID& a_ID);
+			void CreateEntity(const EntityID& a_ID);
+
+			EntityComponentSystem* m_ECS = nullptr;
+			const unsigned char* m_Data = nullptr;
+			std::vector<Frame> m_Frames;
+			std::vector<size_t> m_SystemIndices; /// Recorded system to the index of the system in the ECS, SIZE_MAX if the ECS has none.
+			WorldSnapshot m_World;
+			uint32_t m_Frame = NO_FRAME;
+		};
+	}
+}
\ No newline at end of file
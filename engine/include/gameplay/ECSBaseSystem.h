@@ -4,11 +4,21 @@
 
 // std::is_base_of
 #include <type_traits> 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "gameplay/EntityID.h"
+#include "gameplay/ComponentPool.h"
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/DeltaSnapshot.h"
+#include "gameplay/ECSEvents.h"
+#include "gameplay/ECSStats.h"
+#include "gameplay/TypeIndex.h"
+#include "gameplay/SystemAccess.h"
+#include "gameplay/WorldSnapshot.h"
 #include "gameplay/systems/components/Component.h"
 #include "core/Engine.h"
 
@@ -16,6 +26,9 @@ namespace gallus
 {
 	namespace gameplay
 	{
+		class SnapshotWriter;
+		class SnapshotReader;
+
 		class AbstractECSSystem : public core::System
 		{
 		public:
@@ -27,7 +40,133 @@ namespace gallus
 				return "";
 			}
 
+			/// <summary>
+			/// Retrieves the index of the component type this system stores.
+			/// </summary>
+			/// <returns>Index within ComponentTypeIndex.</returns>
+			virtual size_t GetComponentTypeIndex() const = 0;
+
+			/// <summary>
+			/// Checks whether entities can have more than one component of this system.
+			/// </summary>
+			/// <returns>True if the components are stored in a MultiComponentPool, false for a ComponentPool.</returns>
+			virtual bool StoresMultipleComponents() const
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Declares the component types the system reads and writes in Update. Systems without
+			/// conflicting access are updated at the same time.
+			/// </summary>
+			/// <param name="a_Access">The access description to fill.</param>
+			virtual void DeclareAccess(SystemAccess& a_Access) const = 0;
+
+			/// <summary>
+			/// Sets the counter the system stamps changed components with. Systems that consume their own changes advance
+			/// this counter, never the one of another ECS.
+			/// </summary>
+			/// <param name="a_ChangeTick">The change tick counter of the ECS.</param>
+			virtual void SetChangeTickSource(std::atomic<uint32_t>* a_ChangeTick) = 0;
+
+			/// <summary>
+			/// Sets the bus the system records its component added and removed events into.
+			/// </summary>
+			/// <param name="a_Events">The event bus of the ECS, nullptr stops recording.</param>
+			virtual void SetEventBus(ECSEventBus* a_Events) = 0;
+
+			/// <summary>
+			/// Sets the entity signatures the system keeps up to date. Only the system that owns the pool of a component type gets them.
+			/// </summary>
+			/// <param name="a_Signatures">The entity signatures of the ECS, nullptr stops updating them.</param>
+			void SetSignatures(EntitySignatures* a_Signatures)
+			{
+				m_Signatures = a_Signatures;
+			}
+
+			/// <summary>
+			/// Checks whether the entity signatures reflect which entities have a component of this system.
+			/// </summary>
+			/// <returns>True if the system keeps the signatures up to date, otherwise false.</returns>
+			bool UpdatesSignatures() const
+			{
+				return m_Signatures != nullptr;
+			}
+
+			/// <summary>
+			/// Writes the components of the system as a binary snapshot block. The block starts with the entity column.
+			/// </summary>
+			/// <param name="a_Writer">The writer.</param>
+			/// <param name="a_Count">The number of components that were written.</param>
+			/// <returns>True if the system wrote a block, false if it does not support snapshots.</returns>
+			virtual bool WriteSnapshot(SnapshotWriter& a_Writer, uint32_t& a_Count) const
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Creates components from a binary snapshot block.
+			/// </summary>
+			/// <param name="a_Reader">The reader, positioned at the start of the block.</param>
+			/// <param name="a_Count">The number of components in the block.</param>
+			/// <returns>True if the block was read, otherwise false.</returns>
+			virtual bool ReadSnapshot(SnapshotReader& a_Reader, uint32_t a_Count)
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Writes the components that were added, removed or changed since the previous recorded frame as a delta
+			/// block, and brings the baseline up to date with what was written.
+			/// </summary>
+			/// <param name="a_Writer">The writer.</param>
+			/// <param name="a_Baseline">The components as the decoder knows them, owned by the recorder. Created if empty.</param>
+			/// <param name="a_ChangedSince">First change tick that counts. Components stamped earlier are known to match the baseline.</param>
+			/// <returns>The number of components that were written or removed, 0 if nothing changed or the system does not support deltas.</returns>
+			virtual size_t WriteDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince) const
+			{
+				return 0;
+			}
+
+			/// <summary>
+			/// Applies a delta block written by WriteDelta to a copy of the components, without touching the components of the system.
+			/// </summary>
+			/// <param name="a_Reader">The reader, positioned at the start of the block.</param>
+			/// <param name="a_State">The copy the block is applied to, in the format of SaveComponents. Created if empty.</param>
+			/// <param name="a_Signatures">The signatures that go with the copy, updated for added and removed components.</param>
+			/// <returns>True if the block was applied, otherwise false.</returns>
+			virtual bool ReadDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures)
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Copies the components of the system.
+			/// </summary>
+			/// <param name="a_Copy">The copy to write to. Created if empty, otherwise its allocations are reused.</param>
+			virtual void SaveComponents(std::unique_ptr<AbstractComponentPoolCopy>& a_Copy) const = 0;
+
+			/// <summary>
+			/// Replaces the components of the system with a copy made by SaveComponents.
+			/// Pending component deletions are dropped and all restored components count as changed.
+			/// Entity signatures are not touched, the ECS restores them together with the entities.
+			/// </summary>
+			/// <param name="a_Copy">The copy to restore, nullptr removes all components.</param>
+			virtual void RestoreComponents(const AbstractComponentPoolCopy* a_Copy) = 0;
+
+			/// <summary>
+			/// Fills in the memory and occupancy of the component pool. The name and peak values are filled in by the ECS.
+			/// </summary>
+			/// <param name="a_Stats">The stats to fill.</param>
+			virtual void GetStats(SystemStats& a_Stats) const = 0;
+
 			virtual void DeleteComponent(const EntityID& a_ID) = 0;
+
+			/// <summary>
+			/// Removes the components that were marked with DeleteComponent right away instead of at the next UpdateComponents.
+			/// </summary>
+			virtual void ApplyPendingDeletes() = 0;
+
 			virtual void Update(float a_DeltaTime) = 0;
 			virtual void UpdateComponents(float a_DeltaTime) = 0;
 			virtual bool ContainsID(const EntityID& a_ID) = 0;
@@ -35,6 +174,8 @@ namespace gallus
 			{
 				return nullptr;
 			};
+		protected:
+			EntitySignatures* m_Signatures = nullptr;
 		};
 
 		template <class ComponentType>
@@ -43,6 +184,8 @@ namespace gallus
 			static_assert(std::is_base_of<Component, ComponentType>::value,
 				"ComponentType must be derived from Component");
 		public:
+			static constexpr size_t DEFAULT_CHUNK_BYTES = 16 * 1024; /// Default chunk size of ForEachParallel, small enough to stay in L1.
+
 			bool Initialize() override
 			{
 				return AbstractECSSystem::Initialize();
@@ -50,23 +193,61 @@ namespace gallus
 
 			bool Destroy() override
 			{
-				m_Components.clear();
+				m_Components.Clear();
 				return AbstractECSSystem::Destroy();
 			}
 
 			virtual ~ECSBaseSystem() = default;
 
+			size_t GetComponentTypeIndex() const override
+			{
+				return ComponentTypeIndex::Get<ComponentType>();
+			}
+
+			void DeclareAccess(SystemAccess& a_Access) const override
+			{
+				a_Access.Write<ComponentType>();
+			}
+
 			ComponentType& CreateComponent(const EntityID& a_ID)
 			{
-				if (ContainsID(a_ID))
+				if (ComponentType* existing = m_Components.TryGet(a_ID))
+				{
+					return *existing;
+				}
+
+				ComponentType& component = m_Components.Emplace(a_ID);
+				if (m_Signatures)
 				{
-					return m_Components[a_ID];
+					m_Signatures->Add(a_ID, ComponentTypeIndex::Get<ComponentType>());
 				}
-				ComponentType t;
-				m_Components.insert(std::make_pair(a_ID, t));
-				return m_Components[a_ID];
+				OnComponentAdded(a_ID, component);
+				m_ComponentEvents.RecordAdded(a_ID);
+				return component;
 			};
 
+			/// <summary>
+			/// Gives every entity in the list a copy of a component, growing the pool at most once.
+			/// Entities that already have a component keep it.
+			/// </summary>
+			/// <param name="a_IDs">The entities.</param>
+			/// <param name="a_Count">The number of entities.</param>
+			/// <param name="a_Component">The component to copy.</param>
+			void CreateComponents(const EntityID* a_IDs, size_t a_Count, const ComponentType& a_Component)
+			{
+				const size_t added = m_Components.Insert(a_IDs, a_Count, a_Component);
+				std::vector<ComponentType>& components = m_Components.GetComponents();
+				for (size_t slot = components.size() - added; slot < components.size(); slot++)
+				{
+					if (m_Signatures)
+					{
+						m_Signatures->Add(m_Components.GetEntity(slot), ComponentTypeIndex::Get<ComponentType>());
+					}
+					OnComponentAdded(m_Components.GetEntity(slot), components[slot]);
+					m_ComponentEvents.RecordAdded(m_Components.GetEntity(slot));
+				}
+			}
+
 			size_t GetSize() const
 			{
 				return m_Components.size();
@@ -74,12 +255,135 @@ namespace gallus
 
 			bool HasComponent(const EntityID& a_ID)
 			{
-				return m_Components.count(a_ID) == 1;
+				return m_Components.Contains(a_ID);
 			}
 
 			ComponentType& GetComponent(const EntityID& a_ID)
 			{
-				return ContainsID(a_ID) ? m_Components.at(a_ID) : CreateComponent(a_ID);
+				ComponentType* component = m_Components.TryGet(a_ID);
+				return component ? *component : CreateComponent(a_ID);
+			}
+
+			ComponentPool<ComponentType>& GetComponents()
+			{
+				return m_Components;
+			}
+
+			const ComponentPool<ComponentType>& GetComponents() const
+			{
+				return m_Components;
+			}
+
+			void SetChangeTickSource(std::atomic<uint32_t>* a_ChangeTick) override
+			{
+				m_Components.SetChangeTickSource(a_ChangeTick);
+			}
+
+			void SetEventBus(ECSEventBus* a_Events) override
+			{
+				m_ComponentEvents.Connect(a_Events);
+			}
+
+			void SaveComponents(std::unique_ptr<AbstractComponentPoolCopy>& a_Copy) const override
+			{
+				if (!a_Copy)
+				{
+					a_Copy = std::make_unique<ComponentPoolCopy>();
+				}
+				static_cast<ComponentPoolCopy&>(*a_Copy).m_Pool.CopyFrom(m_Components);
+			}
+
+			void RestoreComponents(const AbstractComponentPoolCopy* a_Copy) override
+			{
+				m_ComponentsToDelete.clear();
+				if (a_Copy)
+				{
+					m_Components.CopyFrom(static_cast<const ComponentPoolCopy*>(a_Copy)->m_Pool);
+					m_Components.MarkAllChanged();
+				}
+				else
+				{
+					m_Components.Clear();
+				}
+				OnComponentsRestored();
+			}
+
+			void GetStats(SystemStats& a_Stats) const override
+			{
+				a_Stats.m_ComponentTypeIndex = GetComponentTypeIndex();
+				a_Stats.m_ComponentSize = sizeof(ComponentType);
+				a_Stats.m_ComponentCount = m_Components.size();
+				a_Stats.m_SlotCount = m_Components.size();
+				a_Stats.m_Capacity = m_Components.GetCapacity();
+				a_Stats.m_SparseSize = m_Components.GetSparseSize();
+				a_Stats.m_AllocatedBytes = m_Components.GetAllocatedBytes() + m_ComponentsToDelete.capacity() * sizeof(EntityID);
+				a_Stats.m_LiveBytes = m_Components.GetLiveBytes();
+				a_Stats.m_PendingDeletes = m_ComponentsToDelete.size();
+				a_Stats.m_Multiple = false;
+			}
+
+			/// <summary>
+			/// Calls the function for every component, spread over the job system. The components are split into
+			/// chunks of a_GrainSize components; chunk boundaries only depend on the amount of components and the grain size.
+			/// Components must not be added or removed while iterating. Every component counts as changed afterwards,
+			/// use the const overload for read-only passes.
+			/// </summary>
+			/// <param name="a_Func">Function with signature void(const EntityID&, ComponentType&).</param>
+			/// <param name="a_GrainSize">Amount of components per chunk. 0 picks a chunk size of DEFAULT_CHUNK_BYTES.</param>
+			template <class Func>
+			void ForEachParallel(Func&& a_Func, size_t a_GrainSize = 0)
+			{
+				struct NoScratch
+				{};
+				std::vector<NoScratch> scratch;
+				ForEachParallel(scratch, [&a_Func](const EntityID& a_ID, ComponentType& a_Component, NoScratch&)
+				{
+					a_Func(a_ID, a_Component);
+				}, a_GrainSize);
+			}
+
+			/// <summary>
+			/// Calls the function for every component without marking any of them as changed, see the non-const overload.
+			/// </summary>
+			/// <param name="a_Func">Function with signature void(const EntityID&, const ComponentType&).</param>
+			/// <param name="a_GrainSize">Amount of components per chunk. 0 picks a chunk size of DEFAULT_CHUNK_BYTES.</param>
+			template <class Func>
+			void ForEachParallel(Func&& a_Func, size_t a_GrainSize = 0) const
+			{
+				struct NoScratch
+				{};
+				std::vector<NoScratch> scratch;
+				ForEachParallel(scratch, [&a_Func](const EntityID& a_ID, const ComponentType& a_Component, NoScratch&)
+				{
+					a_Func(a_ID, a_Component);
+				}, a_GrainSize);
+			}
+
+			/// <summary>
+			/// Calls the function for every component, spread over the job system, with scratch storage that is private
+			/// to the thread processing the chunk. The scratch vector is resized to the amount of threads used, so the
+			/// caller can merge the results afterwards and reuse the allocations next time. Every component counts as
+			/// changed afterwards, use the const overload for read-only passes.
+			/// </summary>
+			/// <param name="a_Scratch">Scratch storage, one entry for every thread that takes part.</param>
+			/// <param name="a_Func">Function with signature void(const EntityID&, ComponentType&, Scratch&).</param>
+			/// <param name="a_GrainSize">Amount of components per chunk. 0 picks a chunk size of DEFAULT_CHUNK_BYTES.</param>
+			template <class Scratch, class Func>
+			void ForEachParallel(std::vector<Scratch>& a_Scratch, Func&& a_Func, size_t a_GrainSize = 0)
+			{
+				ForEachParallelInPool(m_Components, a_Scratch, a_Func, a_GrainSize);
+			}
+
+			/// <summary>
+			/// Calls the function for every component with scratch storage, without marking any of them as changed.
+			/// </summary>
+			/// <param name="a_Scratch">Scratch storage, one entry for every thread that takes part.</param>
+			/// <param name="a_Func">Function with signature void(const EntityID&, const ComponentType&, Scratch&).</param>
+			/// <param name="a_GrainSize">Amount of components per chunk. 0 picks a chunk size of DEFAULT_CHUNK_BYTES.</param>
+			template <class Scratch, class Func>
+			void ForEachParallel(std::vector<Scratch>& a_Scratch, Func&& a_Func, size_t a_GrainSize = 0) const
+			{
+				ForEachParallelInPool(m_Components, a_Scratch, a_Func, a_GrainSize);
 			}
 
 			void DeleteComponent(const EntityID& a_ID)
@@ -96,16 +400,29 @@ namespace gallus
 				return &comp;
 			};
 
-			virtual void UpdateComponents(float a_DeltaTime) override
+			void ApplyPendingDeletes() override
 			{
-				if (!m_ComponentsToDelete.empty())
+				for (EntityID& id : m_ComponentsToDelete)
 				{
-					for (EntityID& id : m_ComponentsToDelete)
+					if (ComponentType* component = m_Components.TryGet(id))
 					{
-						m_Components.erase(id);
+						OnComponentRemoved(id, *component);
+						m_Components.Remove(id);
+						if (m_Signatures)
+						{
+							m_Signatures->Remove(id, ComponentTypeIndex::Get<ComponentType>());
+						}
+						m_ComponentEvents.RecordRemoved(id);
 					}
-					m_ComponentsToDelete.clear();
-					core::ENGINE.GetECS().m_OnEntityComponentsUpdated();
+				}
+				m_ComponentsToDelete.clear();
+			}
+
+			virtual void UpdateComponents(float a_DeltaTime) override
+			{
+				if (!m_ComponentsToDelete.empty())
+				{
+					ApplyPendingDeletes();
 				}
 			}
 
@@ -114,12 +431,219 @@ namespace gallus
 
 			bool ContainsID(const EntityID& a_ID) override
 			{
-				return m_Components.count(a_ID) == 1;
+				return m_Components.Contains(a_ID);
 			}
 		protected:
-			// TODO: We can only have one for each entity. If I want multiple components this will be a problem.
-			std::map<EntityID, ComponentType> m_Components;
+			/// <summary>
+			/// Called right after a component has been added to the pool.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <param name="a_Component">The new component.</param>
+			virtual void OnComponentAdded(const EntityID& a_ID, ComponentType& a_Component)
+			{}
+
+			/// <summary>
+			/// Called right before a component is removed from the pool.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <param name="a_Component">The component that is being removed.</param>
+			virtual void OnComponentRemoved(const EntityID& a_ID, ComponentType& a_Component)
+			{}
+
+			/// <summary>
+			/// Called after the components were replaced by RestoreComponents. OnComponentAdded and OnComponentRemoved
+			/// are not called for restored components, so systems rebuild their own lookups here.
+			/// </summary>
+			virtual void OnComponentsRestored()
+			{}
+
+			class ComponentPoolCopy : public AbstractComponentPoolCopy
+			{
+			public:
+				ComponentPool<ComponentType> m_Pool;
+			};
+
+			/// <summary>
+			/// Writes a delta block for WriteDelta: the removed components, then every added or changed component with its
+			/// fields. Components are only compared if they were stamped since a_ChangedSince or are new to the baseline.
+			/// </summary>
+			/// <param name="a_Writer">The writer.</param>
+			/// <param name="a_Baseline">The baseline, created as a ComponentPoolCopy if empty.</param>
+			/// <param name="a_ChangedSince">First change tick that counts.</param>
+			/// <param name="a_WriteFields">Function with signature bool(DeltaWriter&, const ComponentType& current, const ComponentType& previous)
+			/// that writes which fields differ, always, followed by those fields and returns whether there were any. Entries of unchanged components are
+			/// rewound, added components are compared against a default constructed one and always kept.</param>
+			/// <returns>The number of components that were written or removed.</returns>
+			template <class WriteFunc>
+			size_t WriteComponentDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince, WriteFunc&& a_WriteFields) const
+			{
+				if (!a_Baseline)
+				{
+					a_Baseline = std::make_unique<ComponentPoolCopy>();
+				}
+				ComponentPool<ComponentType>& baseline = static_cast<ComponentPoolCopy&>(*a_Baseline).m_Pool;
+				const ComponentPool<ComponentType>& pool = m_Components;
+				size_t written = 0;
+
+				// Removals come first, so a decoder never sees a new occupant of an index while the previous one still has a component.
+				size_t added = 0;
+				for (size_t slot = 0; slot < pool.size(); slot++)
+				{
+					if (!baseline.Contains(pool.GetEntity(slot)))
+					{
+						added++;
+					}
+				}
+				if (baseline.size() + added > pool.size())
+				{
+					// Going backwards, the component moved into a freed slot has already been looked at.
+					for (size_t slot = baseline.size(); slot-- > 0;)
+					{
+						const EntityID id = baseline.GetEntity(slot);
+						if (!pool.Contains(id))
+						{
+							a_Writer.WriteBool(true);
+							a_Writer.WriteEntity(id);
+							baseline.Remove(id);
+							written++;
+						}
+					}
+				}
+				a_Writer.WriteBool(false);
+
+				const ComponentType defaultComponent;
+				for (size_t slot = 0; slot < pool.size(); slot++)
+				{
+					const EntityID& id = pool.GetEntity(slot);
+					const uint32_t baselineSlot = baseline.GetSlot(id);
+					const bool isNew = baselineSlot == ComponentPool<ComponentType>::INVALID_SLOT;
+					if (!isNew && pool.GetVersion(slot) < a_ChangedSince)
+					{
+						continue;
+					}
+
+					const DeltaWriter::Position position = a_Writer.GetPosition();
+					a_Writer.WriteBool(true);
+					a_Writer.WriteEntity(id);
+					if (!a_WriteFields(a_Writer, pool[slot], isNew ? defaultComponent : baseline.GetComponents()[baselineSlot]) && !isNew)
+					{
+						a_Writer.Rewind(position);
+						continue;
+					}
+
+					if (isNew)
+					{
+						baseline.Emplace(id) = pool[slot];
+					}
+					else
+					{
+						baseline.GetComponents()[baselineSlot] = pool[slot];
+					}
+					written++;
+				}
+				a_Writer.WriteBool(false);
+				return written;
+			}
+
+			/// <summary>
+			/// Applies a delta block written by WriteComponentDelta for ReadDelta.
+			/// </summary>
+			/// <param name="a_Reader">The reader.</param>
+			/// <param name="a_State">The copy to apply the block to, created as a ComponentPoolCopy if empty.</param>
+			/// <param name="a_Signatures">The signatures that go with the copy.</param>
+			/// <param name="a_ReadFields">Function with signature bool(DeltaReader&, const EntityID&, ComponentType&) that reads the
+			/// fields written by the write function into the component. Added components start out default constructed.</param>
+			/// <returns>True if the block was applied, otherwise false.</returns>
+			template <class ReadFunc>
+			bool ReadComponentDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures, ReadFunc&& a_ReadFields)
+			{
+				if (!a_State)
+				{
+					a_State = std::make_unique<ComponentPoolCopy>();
+				}
+				ComponentPool<ComponentType>& state = static_cast<ComponentPoolCopy&>(*a_State).m_Pool;
+				const size_t type = ComponentTypeIndex::Get<ComponentType>();
+
+				while (a_Reader.ReadBool())
+				{
+					const EntityID id = a_Reader.ReadEntity();
+					if (state.Remove(id))
+					{
+						a_Signatures.Remove(id, type);
+					}
+				}
+
+				while (a_Reader.ReadBool())
+				{
+					const EntityID id = a_Reader.ReadEntity();
+					if (!id.IsValid())
+					{
+						return false;
+					}
+
+					ComponentType* component = state.TryGet(id);
+					if (!component)
+					{
+						component = &state.Emplace(id);
+						a_Signatures.Add(id, type);
+					}
+					if (!a_ReadFields(a_Reader, id, *component))
+					{
+						return false;
+					}
+				}
+				return !a_Reader.HasFailed();
+			}
+
+			// Only one component per entity, systems that need more derive from ECSMultiSystem.
+			ComponentPool<ComponentType> m_Components;
 			std::vector<EntityID> m_ComponentsToDelete;
+			ComponentEventQueues<ComponentType> m_ComponentEvents;
+		private:
+			/// <summary>
+			/// Shared implementation of ForEachParallel. Indexing a non-const pool marks the components as changed, a const pool does not.
+			/// </summary>
+			template <class Pool, class Scratch, class Func>
+			static void ForEachParallelInPool(Pool& a_Pool, std::vector<Scratch>& a_Scratch, Func& a_Func, size_t a_GrainSize)
+			{
+				const size_t count = a_Pool.size();
+				const size_t grainSize = a_GrainSize != 0 ? a_GrainSize : std::max<size_t>(1, DEFAULT_CHUNK_BYTES / sizeof(ComponentType));
+				const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+				core::JobSystem& jobSystem = core::ENGINE.GetJobSystem();
+				const size_t laneCount = std::min(chunkCount, jobSystem.GetWorkerCount() + 1);
+				a_Scratch.resize(laneCount);
+				if (laneCount == 0)
+				{
+					return;
+				}
+
+				// Every lane keeps taking the next chunk until none are left, so faster lanes end up doing more chunks.
+				std::atomic<size_t> nextChunk{ 0 };
+				auto runLane = [&a_Pool, &a_Scratch, &a_Func, &nextChunk, count, grainSize, chunkCount](size_t a_Lane)
+				{
+					Scratch& scratch = a_Scratch[a_Lane];
+					for (size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount; chunk = nextChunk.fetch_add(1, std::memory_order_relaxed))
+					{
+						const size_t end = std::min(count, (chunk + 1) * grainSize);
+						for (size_t slot = chunk * grainSize; slot < end; slot++)
+						{
+							a_Func(a_Pool.GetEntity(slot), a_Pool[slot], scratch);
+						}
+					}
+				};
+
+				core::JobGroup group;
+				for (size_t lane = 1; lane < laneCount; lane++)
+				{
+					jobSystem.Run(group, [&runLane, lane]()
+					{
+						runLane(lane);
+					});
+				}
+				runLane(0);
+				jobSystem.Wait(group);
+			}
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+#include "gameplay/TypeIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// An entity became valid.
+		/// </summary>
+		struct EntityCreatedEvent
+		{
+			EntityID m_ID;
+		};
+
+		/// <summary>
+		/// An entity was deleted. Its components are removed in the same update.
+		/// </summary>
+		struct EntityDestroyedEvent
+		{
+			EntityID m_ID;
+		};
+
+		/// <summary>
+		/// A component was added to an entity. Entities with several components of a type get one event per component.
+		/// </summary>
+		/// <typeparam name="ComponentType">The component type.</typeparam>
+		template <class ComponentType>
+		struct ComponentAddedEvent
+		{
+			EntityID m_ID;
+		};
+
+		/// <summary>
+		/// A component was removed from an entity.
+		/// </summary>
+		/// <typeparam name="ComponentType">The component type.</typeparam>
+		template <class ComponentType>
+		struct ComponentRemovedEvent
+		{
+			EntityID m_ID;
+		};
+
+		/// <summary>
+		/// A component of any type was added to or removed from an entity, for listeners that do not care about the type.
+		/// </summary>
+		struct EntityComponentsChangedEvent
+		{
+			EntityID m_ID;
+			size_t m_ComponentType = 0; /// Index of the component type within ComponentTypeIndex.
+			bool m_Added = false; /// True if the component was added, false if it was removed.
+		};
+
+		/// <summary>
+		/// The whole world was replaced, for example when leaving play mode. Events recorded before the
+		/// replacement are dropped, so listeners have to rebuild everything they derived from the world.
+		/// </summary>
+		struct WorldRestoredEvent
+		{};
+
+		using SubscriptionID = uint32_t;
+
+		class AbstractEventQueue
+		{
+		public:
+			virtual ~AbstractEventQueue() = default;
+
+			/// <summary>
+			/// Delivers the recorded events to the subscribers.
+			/// </summary>
+			virtual void Dispatch() = 0;
+
+			/// <summary>
+			/// Drops the recorded events without delivering them.
+			/// </summary>
+			virtual void Clear() = 0;
+		};
+
+		/// <summary>
+		/// Queue of events of a single type. Events are appended to a contiguous buffer and every subscriber receives all
+		/// of them at once when the queue is dispatched. Events are only recorded while there are subscribers.
+		/// Events recorded by a subscriber while the queue is being dispatched are delivered at the next dispatch.
+		/// </summary>
+		/// <typeparam name="EventType">The event type.</typeparam>
+		template <class EventType>
+		class EventQueue : public AbstractEventQueue
+		{
+		public:
+			using Handler = std::function<void(std::span<const EventType>)>;
+
+			/// <summary>
+			/// Adds a subscriber.
+			/// </summary>
+			/// <param name="a_Handler">Function that receives the batch of events.</param>
+			/// <returns>The id to unsubscribe with.</returns>
+			SubscriptionID Subscribe(Handler a_Handler)
+			{
+				const SubscriptionID id = m_NextSubscriptionID++;
+
+				// Growing the list while it is being dispatched would move the handler that is running.
+				std::vector<Subscriber>& subscribers = m_Dispatching ? m_NewSubscribers : m_Subscribers;
+				subscribers.push_back({ id, std::move(a_Handler) });
+				return id;
+			}
+
+			/// <summary>
+			/// Removes a subscriber. Subscribers can unsubscribe from within their handler.
+			/// </summary>
+			/// <param name="a_ID">The id returned by Subscribe.</param>
+			void Unsubscribe(SubscriptionID a_ID)
+			{
+				for (std::vector<Subscriber>* subscribers : { &m_Subscribers, &m_NewSubscribers })
+				{
+					for (Subscriber& subscriber : *subscribers)
+					{
+						// The handler is only destroyed once it is certainly not running.
+						if (subscriber.m_ID == a_ID)
+						{
+							subscriber.m_Active = false;
+						}
+					}
+				}
+				if (!m_Dispatching)
+				{
+					RemoveUnsubscribed();
+				}
+			}
+
+			/// <summary>
+			/// Checks whether the queue has subscribers, and thus records events.
+			/// </summary>
+			/// <returns>True if there are subscribers, otherwise false.</returns>
+			bool HasSubscribers() const
+			{
+				return !m_Subscribers.empty() || !m_NewSubscribers.empty();
+			}
+
+			/// <summary>
+			/// Records an event for the next dispatch.
+			/// </summary>
+			/// <param name="a_Event">The event.</param>
+			void Push(const EventType& a_Event)
+			{
+				if (HasSubscribers())
+				{
+					m_Events.push_back(a_Event);
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the number of events waiting for the next dispatch.
+			/// </summary>
+			/// <returns>The number of events.</returns>
+			size_t GetPendingCount() const
+			{
+				return m_Events.size();
+			}
+
+			void Dispatch() override
+			{
+				if (!m_Events.empty())
+				{
+					// The buffers are swapped so both keep their allocations from frame to frame.
+					std::swap(m_Events, m_Delivering);
+					m_Dispatching = true;
+					const std::span<const EventType> events(m_Delivering);
+					for (Subscriber& subscriber : m_Subscribers)
+					{
+						if (subscriber.m_Active)
+						{
+							subscriber.m_Handler(events);
+						}
+					}
+					m_Dispatching = false;
+					m_Delivering.clear();
+				}
+
+				if (!m_NewSubscribers.empty())
+				{
+					std::move(m_NewSubscribers.begin(), m_NewSubscribers.end(), std::back_inserter(m_Subscribers));
+					m_NewSubscribers.clear();
+				}
+				RemoveUnsubscribed();
+			}
+
+			void Clear() override
+			{
+				m_Events.clear();
+			}
+		private:
+			struct Subscriber
+			{
+				SubscriptionID m_ID = 0;
+				Handler m_Handler;
+				bool m_Active = true; /// False once unsubscribed.
+			};
+
+			void RemoveUnsubscribed()
+			{
+				for (std::vector<Subscriber>* subscribers : { &m_Subscribers, &m_NewSubscribers })
+				{
+					std::erase_if(*subscribers, [](const Subscriber& a_Subscriber)
+					{
+						return !a_Subscriber.m_Active;
+					});
+				}
+			}
+
+			std::vector<EventType> m_Events; /// Events recorded since the last dispatch.
+			std::vector<EventType> m_Delivering; /// Events that are being delivered.
+			std::vector<Subscriber> m_Subscribers;
+			std::vector<Subscriber> m_NewSubscribers; /// Subscribed while dispatching, added after the dispatch.
+			SubscriptionID m_NextSubscriptionID = 1;
+			bool m_Dispatching = false;
+		};
+
+		/// <summary>
+		/// Owns one event queue for every event type. Queues are created on first use and dispatched together,
+		/// in the order they were created. Events are recorded where the structural change is made, so the bus follows
+		/// the same rules: use it while holding EntityComponentSystem::m_EntityMutex or from the thread that updates the ECS.
+		/// </summary>
+		class ECSEventBus
+		{
+		public:
+			/// <summary>
+			/// Retrieves the queue of an event type, creating it if it does not exist yet. The queue lives as long as the bus.
+			/// </summary>
+			/// <typeparam name="EventType">The event type.</typeparam>
+			/// <returns>Reference to the queue.</returns>
+			template <class EventType>
+			EventQueue<EventType>& Get()
+			{
+				const size_t index = EventTypeIndex::Get<EventType>();
+				if (index >= m_QueuesByType.size())
+				{
+					m_QueuesByType.resize(index + 1, nullptr);
+				}
+				if (!m_QueuesByType[index])
+				{
+					m_Queues.push_back(std::make_unique<EventQueue<EventType>>());
+					m_QueuesByType[index] = m_Queues.back().get();
+				}
+				return *static_cast<EventQueue<EventType>*>(m_QueuesByType[index]);
+			}
+
+			/// <summary>
+			/// Delivers the recorded events of every queue.
+			/// </summary>
+			void Dispatch()
+			{
+				// Indexed, so handlers can create queues while the bus is dispatching.
+				for (size_t i = 0; i < m_Queues.size(); i++)
+				{
+					m_Queues[i]->Dispatch();
+				}
+			}
+
+			/// <summary>
+			/// Drops the recorded events of every queue without delivering them.
+			/// </summary>
+			void Clear()
+			{
+				for (std::unique_ptr<AbstractEventQueue>& queue : m_Queues)
+				{
+					queue->Clear();
+				}
+			}
+		private:
+			std::vector<std::unique_ptr<AbstractEventQueue>> m_Queues; /// Queues in the order they were created.
+			std::vector<AbstractEventQueue*> m_QueuesByType; /// Indexed by EventTypeIndex.
+		};
+
+		/// <summary>
+		/// The queues a component system records its component events into.
+		/// </summary>
+		/// <typeparam name="ComponentType">The component type.</typeparam>
+		template <class ComponentType>
+		class ComponentEventQueues
+		{
+		public:
+			/// <summary>
+			/// Looks up the queues on the bus.
+			/// </summary>
+			/// <param name="a_Events">The bus, nullptr stops recording.</param>
+			void Connect(ECSEventBus* a_Events)
+			{
+				m_Added = a_Events ? &a_Events->Get<ComponentAddedEvent<ComponentType>>() : nullptr;
+				m_Removed = a_Events ? &a_Events->Get<ComponentRemovedEvent<ComponentType>>() : nullptr;
+				m_Changed = a_Events ? &a_Events->Get<EntityComponentsChangedEvent>() : nullptr;
+			}
+
+			void RecordAdded(const EntityID& a_ID)
+			{
+				if (m_Added)
+				{
+					m_Added->Push({ a_ID });
+					m_Changed->Push({ a_ID, ComponentTypeIndex::Get<ComponentType>(), true });
+				}
+			}
+
+			void RecordRemoved(const EntityID& a_ID)
+			{
+				if (m_Removed)
+				{
+					m_Removed->Push({ a_ID });
+					m_Changed->Push({ a_ID, ComponentTypeIndex::Get<ComponentType>(), false });
+				}
+			}
+		private:
+			EventQueue<ComponentAddedEvent<ComponentType>>* m_Added = nullptr;
+			EventQueue<ComponentRemovedEvent<ComponentType>>* m_Removed = nullptr;
+			EventQueue<EntityComponentsChangedEvent>* m_Changed = nullptr;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gameplay/ECSBaseSystem.h"
+#include "gameplay/MultiComponentPool.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Base for systems whose entities can have several components of the same type, such as mesh parts,
+		/// lights and colliders. The components are stored in a MultiComponentPool.
+		/// Multi-component types can not be used in views, iterate the pool instead.
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component the system stores.</typeparam>
+		template <class ComponentType>
+		class ECSMultiSystem : public AbstractECSSystem
+		{
+			static_assert(std::is_base_of<Component, ComponentType>::value,
+				"ComponentType must be derived from Component");
+		public:
+			bool Destroy() override
+			{
+				m_Components.Clear();
+				return AbstractECSSystem::Destroy();
+			}
+
+			virtual ~ECSMultiSystem() = default;
+
+			size_t GetComponentTypeIndex() const override
+			{
+				return ComponentTypeIndex::Get<ComponentType>();
+			}
+
+			bool StoresMultipleComponents() const override
+			{
+				return true;
+			}
+
+			void DeclareAccess(SystemAccess& a_Access) const override
+			{
+				a_Access.Write<ComponentType>();
+			}
+
+			void SetChangeTickSource(std::atomic<uint32_t>* a_ChangeTick) override
+			{
+				m_Components.SetChangeTickSource(a_ChangeTick);
+			}
+
+			void SetEventBus(ECSEventBus* a_Events) override
+			{
+				m_ComponentEvents.Connect(a_Events);
+			}
+
+			/// <summary>
+			/// Adds a component to an entity. Other components of the entity stay where they are in its list.
+			/// Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>Reference to the new component, valid until the next structural change of the pool.</returns>
+			ComponentType& AddComponent(const EntityID& a_ID)
+			{
+				ComponentType& component = m_Components.Add(a_ID);
+				if (m_Signatures)
+				{
+					m_Signatures->Add(a_ID, ComponentTypeIndex::Get<ComponentType>());
+				}
+				OnComponentAdded(a_ID, component);
+				m_ComponentEvents.RecordAdded(a_ID);
+				return component;
+			}
+
+			/// <summary>
+			/// Retrieves all components of an entity, in the order they were added.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The components, empty if the entity has none.</returns>
+			std::span<ComponentType> GetComponents(const EntityID& a_ID)
+			{
+				return m_Components.Get(a_ID);
+			}
+
+			std::span<const ComponentType> GetComponents(const EntityID& a_ID) const
+			{
+				return std::as_const(m_Components).Get(a_ID);
+			}
+
+			size_t GetComponentCount(const EntityID& a_ID) const
+			{
+				return m_Components.Count(a_ID);
+			}
+
+			size_t GetSize() const
+			{
+				return m_Components.size();
+			}
+
+			MultiComponentPool<ComponentType>& GetPool()
+			{
+				return m_Components;
+			}
+
+			const MultiComponentPool<ComponentType>& GetPool() const
+			{
+				return m_Components;
+			}
+
+			/// <summary>
+			/// Removes one component of an entity at the start of the next update.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_Instance">Position of the component within the entity's components, as of now.</param>
+			void DeleteComponent(const EntityID& a_ID, size_t a_Instance)
+			{
+				if (a_ID.IsValid() && a_Instance < m_Components.Count(a_ID))
+				{
+					m_InstancesToDelete.emplace_back(a_ID, a_Instance);
+				}
+			}
+
+			/// <summary>
+			/// Removes all components of an entity at the start of the next update.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			void DeleteComponent(const EntityID& a_ID) override
+			{
+				if (a_ID.IsValid() && ContainsID(a_ID))
+				{
+					m_ComponentsToDelete.push_back(a_ID);
+				}
+			}
+
+			/// <summary>
+			/// Adds a new component to the entity. Used by command buffers, which always add.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The new component.</returns>
+			Component* GetBaseComponent(const EntityID& a_ID) override
+			{
+				return &AddComponent(a_ID);
+			}
+
+			bool ContainsID(const EntityID& a_ID) override
+			{
+				return m_Components.Contains(a_ID);
+			}
+
+			void SaveComponents(std::unique_ptr<AbstractComponentPoolCopy>& a_Copy) const override
+			{
+				if (!a_Copy)
+				{
+					a_Copy = std::make_unique<ComponentPoolCopy>();
+				}
+				static_cast<ComponentPoolCopy&>(*a_Copy).m_Pool.CopyFrom(m_Components);
+			}
+
+			void RestoreComponents(const AbstractComponentPoolCopy* a_Copy) override
+			{
+				m_ComponentsToDelete.clear();
+				m_InstancesToDelete.clear();
+				if (a_Copy)
+				{
+					m_Components.CopyFrom(static_cast<const ComponentPoolCopy*>(a_Copy)->m_Pool);
+				}
+				else
+				{
+					m_Components.Clear();
+				}
+			}
+
+			void GetStats(SystemStats& a_Stats) const override
+			{
+				a_Stats.m_ComponentTypeIndex = GetComponentTypeIndex();
+				a_Stats.m_ComponentSize = sizeof(ComponentType);
+				a_Stats.m_ComponentCount = m_Components.size();
+				a_Stats.m_SlotCount = m_Components.GetSlotCount();
+				a_Stats.m_Capacity = m_Components.GetCapacity();
+				a_Stats.m_SparseSize = m_Components.GetSparseSize();
+				a_Stats.m_AllocatedBytes = m_Components.GetAllocatedBytes() + m_ComponentsToDelete.capacity() * sizeof(EntityID) + m_InstancesToDelete.capacity() * sizeof(std::pair<EntityID, size_t>);
+				a_Stats.m_LiveBytes = m_Components.GetLiveBytes();
+				a_Stats.m_PendingDeletes = m_ComponentsToDelete.size() + m_InstancesToDelete.size();
+				a_Stats.m_Multiple = true;
+			}
+
+			void ApplyPendingDeletes() override
+			{
+				// Highest instance first, so the positions of the other pending deletions stay correct. Deleting the same instance twice only deletes it once.
+				std::sort(m_InstancesToDelete.begin(), m_InstancesToDelete.end(), [](const std::pair<EntityID, size_t>& a_Lhs, const std::pair<EntityID, size_t>& a_Rhs)
+				{
+					return a_Lhs.second != a_Rhs.second ? a_Lhs.second > a_Rhs.second : a_Lhs.first < a_Rhs.first;
+				});
+				m_InstancesToDelete.erase(std::unique(m_InstancesToDelete.begin(), m_InstancesToDelete.end()), m_InstancesToDelete.end());
+				for (const std::pair<EntityID, size_t>& instance : m_InstancesToDelete)
+				{
+					std::span<ComponentType> components = m_Components.Get(instance.first);
+					if (instance.second < components.size())
+					{
+						OnComponentRemoved(instance.first, components[instance.second]);
+						m_Components.Remove(instance.first, instance.second);
+						m_ComponentEvents.RecordRemoved(instance.first);
+
+						// The entity keeps the type in its signature until its last component is gone.
+						if (m_Signatures && !m_Components.Contains(instance.first))
+						{
+							m_Signatures->Remove(instance.first, ComponentTypeIndex::Get<ComponentType>());
+						}
+					}
+				}
+				m_InstancesToDelete.clear();
+
+				for (const EntityID& id : m_ComponentsToDelete)
+				{
+					for (ComponentType& component : m_Components.Get(id))
+					{
+						OnComponentRemoved(id, component);
+						m_ComponentEvents.RecordRemoved(id);
+					}
+					m_Components.RemoveAll(id);
+					if (m_Signatures)
+					{
+						m_Signatures->Remove(id, ComponentTypeIndex::Get<ComponentType>());
+					}
+				}
+				m_ComponentsToDelete.clear();
+			}
+
+			void UpdateComponents(float a_DeltaTime) override
+			{
+				ApplyPendingDeletes();
+
+				// Nothing else touches the pool at this point, so this is where the gaps are closed.
+				m_Components.Compact();
+			}
+
+			void Update(float a_DeltaTime) override
+			{}
+		protected:
+			/// <summary>
+			/// Called right after a component has been added to the pool.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <param name="a_Component">The new component.</param>
+			virtual void OnComponentAdded(const EntityID& a_ID, ComponentType& a_Component)
+			{}
+
+			/// <summary>
+			/// Called right before a component is removed from the pool.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <param name="a_Component">The component that is being removed.</param>
+			virtual void OnComponentRemoved(const EntityID& a_ID, ComponentType& a_Component)
+			{}
+
+			class ComponentPoolCopy : public AbstractComponentPoolCopy
+			{
+			public:
+				MultiComponentPool<ComponentType> m_Pool;
+			};
+
+			MultiComponentPool<ComponentType> m_Components;
+			std::vector<EntityID> m_ComponentsToDelete;
+			std::vector<std::pair<EntityID, size_t>> m_InstancesToDelete;
+			ComponentEventQueues<ComponentType> m_ComponentEvents;
+		};
+	}
+}
\ No newline at end of file
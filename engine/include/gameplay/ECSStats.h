@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Memory and occupancy of the component pool of a single system, filled by AbstractECSSystem::GetStats.
+		/// Allocated bytes count the capacity of every array of the pool, live bytes only the dense entries that hold a component.
+		/// </summary>
+		struct SystemStats
+		{
+			std::string m_Name; /// Property name of the system.
+			size_t m_ComponentTypeIndex = 0;
+			size_t m_ComponentSize = 0; /// Size of a single component in bytes.
+			size_t m_ComponentCount = 0; /// Number of live components.
+			size_t m_SlotCount = 0; /// Number of dense slots in use, including gaps.
+			size_t m_Capacity = 0; /// Number of dense slots allocated.
+			size_t m_SparseSize = 0; /// Number of entries in the entity-to-slot table.
+			size_t m_AllocatedBytes = 0;
+			size_t m_LiveBytes = 0;
+			size_t m_PendingDeletes = 0; /// Component deletions that are applied at the next update.
+			size_t m_PeakComponentCount = 0; /// Highest component count seen at an update.
+			size_t m_PeakAllocatedBytes = 0; /// Highest allocated bytes seen at an update.
+			bool m_Multiple = false; /// Whether entities can have several components of this system.
+		};
+
+		/// <summary>
+		/// Memory and occupancy of the whole ECS, filled by EntityComponentSystem::GetStats.
+		/// Filling a stats object that was used before reuses its allocations.
+		/// </summary>
+		struct ECSStats
+		{
+			size_t m_EntityCount = 0;
+			size_t m_EntityIndexCount = 0; /// Number of entity indices ever handed out.
+			size_t m_PeakEntityCount = 0; /// Highest entity count seen at an update.
+			size_t m_EntityTableBytes = 0; /// Bytes allocated for the entity bookkeeping.
+			size_t m_ReservedHandles = 0; /// Handles reserved since the last update.
+			size_t m_ReservableHandles = 0; /// Recycled handles that are ready to be reserved.
+			size_t m_PendingCreates = 0; /// Recorded in command buffers and applied at the next update.
+			size_t m_PendingDestroys = 0;
+			size_t m_PendingAdds = 0;
+			size_t m_PendingRemoves = 0;
+			size_t m_CommandBufferCount = 0;
+			size_t m_AllocatedBytes = 0; /// Entity tables and all component pools.
+			size_t m_LiveBytes = 0; /// Live entries of all component pools.
+			size_t m_SpatialIndexCount = 0; /// Number of entities in the spatial index.
+			size_t m_SpatialIndexHeight = 0;
+			size_t m_SpatialIndexBytes = 0;
+			std::vector<SystemStats> m_Systems; /// One entry for every system, in registration order.
+		};
+	}
+}
\ No newline at end of file
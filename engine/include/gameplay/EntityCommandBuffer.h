@@ -0,0 +1,144 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+#include "gameplay/TypeIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		class Component;
+		class EntityComponentSystem;
+
+		/// <summary>
+		/// Records structural changes to the ECS so they can be made from any thread. Every thread records into its own
+		/// buffer (see EntityComponentSystem::GetCommandBuffer) and all buffers are applied together at the start of the
+		/// next ECS update. Creates of all buffers are applied first, after that the other commands of every buffer are
+		/// applied in the order they were recorded.
+		/// </summary>
+		class EntityCommandBuffer
+		{
+		public:
+			EntityCommandBuffer(EntityComponentSystem& a_ECS) : m_ECS(a_ECS)
+			{}
+
+			/// <summary>
+			/// Records the creation of an entity. The returned handle can be used in further commands right away,
+			/// but the entity only becomes valid once the buffer has been applied.
+			/// </summary>
+			/// <param name="a_Name">The name of the entity.</param>
+			/// <returns>The handle of the entity that will be created.</returns>
+			EntityID CreateEntity(const std::string& a_Name);
+
+			/// <summary>
+			/// Records the destruction of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity to destroy.</param>
+			void DestroyEntity(const EntityID& a_ID);
+
+			/// <summary>
+			/// Records adding a component to an entity.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <param name="a_ID">The entity that gets the component.</param>
+			template <class ComponentType>
+			void AddComponent(const EntityID& a_ID)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Commands.push_back({ CommandType::AddComponent, a_ID, ComponentTypeIndex::Get<ComponentType>() });
+			}
+
+			/// <summary>
+			/// Records adding a component to an entity and initializing it once it has been added.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <param name="a_ID">The entity that gets the component.</param>
+			/// <param name="a_Init">Function with signature void(ComponentType&), called when the buffer is applied.</param>
+			template <class ComponentType, class Func>
+			void AddComponent(const EntityID& a_ID, Func&& a_Init)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Commands.push_back({ CommandType::AddComponent, a_ID, ComponentTypeIndex::Get<ComponentType>(), [init = std::forward<Func>(a_Init)](Component& a_Component)
+				{
+					init(static_cast<ComponentType&>(a_Component));
+				} });
+			}
+
+			/// <summary>
+			/// Records removing a component from an entity.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <param name="a_ID">The entity that loses the component.</param>
+			template <class ComponentType>
+			void RemoveComponent(const EntityID& a_ID)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Commands.push_back({ CommandType::RemoveComponent, a_ID, ComponentTypeIndex::Get<ComponentType>() });
+			}
+
+			/// <summary>
+			/// Records giving an entity a tag.
+			/// </summary>
+			/// <typeparam name="TagType">The tag type, an empty struct.</typeparam>
+			/// <param name="a_ID">The entity that gets the tag.</param>
+			template <class TagType>
+			void AddTag(const EntityID& a_ID)
+			{
+				static_assert(std::is_empty_v<TagType>, "TagType must be an empty type");
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Commands.push_back({ CommandType::AddTag, a_ID, ComponentTypeIndex::Get<TagType>() });
+			}
+
+			/// <summary>
+			/// Records taking a tag away from an entity.
+			/// </summary>
+			/// <typeparam name="TagType">The tag type, an empty struct.</typeparam>
+			/// <param name="a_ID">The entity that loses the tag.</param>
+			template <class TagType>
+			void RemoveTag(const EntityID& a_ID)
+			{
+				static_assert(std::is_empty_v<TagType>, "TagType must be an empty type");
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Commands.push_back({ CommandType::RemoveTag, a_ID, ComponentTypeIndex::Get<TagType>() });
+			}
+		private:
+			friend class EntityComponentSystem;
+
+			struct CreateCommand
+			{
+				EntityID m_ID;
+				std::string m_Name;
+			};
+
+			enum class CommandType
+			{
+				AddComponent,
+				RemoveComponent,
+				AddTag,
+				RemoveTag,
+				DestroyEntity
+			};
+
+			struct Command
+			{
+				CommandType m_Type = CommandType::AddComponent;
+				EntityID m_ID;
+				size_t m_TypeIndex = 0; /// Component or tag type, unused for destroys.
+				std::function<void(Component&)> m_Init; /// Only set for component adds with an initializer.
+			};
+
+			EntityComponentSystem& m_ECS;
+
+			// Only the owning thread records into the buffer, so this lock is only contended while the ECS applies the buffer.
+			std::mutex m_Mutex;
+			std::vector<CreateCommand> m_Creates;
+			std::vector<Command> m_Commands; /// Everything but creates, in the order it was recorded.
+		};
+	}
+}
\ No newline at end of file
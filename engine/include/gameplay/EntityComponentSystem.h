@@ -2,25 +2,49 @@
 
 #include "core/System.h"
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
 #include <mutex>
+#include <shared_mutex>
+#include <type_traits>
 
 #include "gameplay/EntityID.h"
-#include "core/Event.h"
+#include "gameplay/EntityCommandBuffer.h"
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/ComponentView.h"
+#include "gameplay/ECSEvents.h"
+#include "gameplay/ECSStats.h"
+#include "gameplay/MultiComponentPool.h"
+#include "gameplay/SpatialIndex.h"
+#include "gameplay/TypeIndex.h"
+#include "gameplay/WorldSnapshot.h"
 
 namespace gallus
 {
+	namespace graphics
+	{
+		namespace dx12
+		{
+			class Transform;
+			class RenderListBuffer;
+		}
+	}
 	namespace gameplay
 	{
 		class AbstractECSSystem;
+		class Prefab;
+
+		template <class ComponentType>
+		class ECSBaseSystem;
+
+		template <class ComponentType>
+		class ECSMultiSystem;
 
 		class EntityComponentSystem : public core::System
 		{
 		public:
-			SimpleEvent<> m_OnEntitiesUpdated;
-			SimpleEvent<> m_OnEntityComponentsUpdated;
-
 			bool Initialize() override;
 			bool Destroy() override;
 
@@ -30,58 +54,471 @@ namespace gallus
 			void SetPaused(bool a_Paused);
 
 			bool HasStarted() const;
+
+			/// <summary>
+			/// Starts or stops the simulation. In the editor, starting saves the world at the next update
+			/// and stopping restores that world, so everything that happened in play mode is undone.
+			/// Other threads than the one updating the ECS must hold m_EntityMutex.
+			/// </summary>
+			/// <param name="a_Started">Whether the simulation runs.</param>
 			void SetStarted(bool a_Started);
 
+			/// <summary>
+			/// Copies the entities and all components into a snapshot. Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <param name="a_Snapshot">The snapshot to write to, its allocations are reused.</param>
+			void SaveWorld(WorldSnapshot& a_Snapshot);
+
+			/// <summary>
+			/// Replaces the entities and all components with the contents of a snapshot. Commands that were recorded but
+			/// not applied yet and handles reserved since the snapshot was made are dropped.
+			/// Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <param name="a_Snapshot">The snapshot to restore.</param>
+			/// <returns>True if the world was restored, false if the snapshot does not hold a world of this ECS.</returns>
+			bool RestoreWorld(const WorldSnapshot& a_Snapshot);
+
+			/// <summary>
+			/// Retrieves the event bus. Entity, component and world events recorded during a frame are delivered in
+			/// batches at the end of the structural change block of the next update, while m_EntityMutex is held.
+			/// Subscribe while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <returns>Reference to the event bus.</returns>
+			ECSEventBus& GetEvents();
+
+			/// <summary>
+			/// Retrieves the spatial index over the bounds of every entity with a transform. Entities with a mesh use the bounds
+			/// of the mesh, other entities a unit cube. The index is brought up to date in the structural change block of every
+			/// update, so systems can query it while they update and other threads can query it while holding m_EntityMutex.
+			/// </summary>
+			/// <returns>Reference to the spatial index.</returns>
+			const SpatialIndex& GetSpatialIndex() const;
+
+			/// <summary>
+			/// Copies the world matrix and render resources of every entity with a transform and a mesh into the write list
+			/// of a render list buffer and publishes it, so the render thread never reads components. Takes m_EntityMutex.
+			/// </summary>
+			/// <param name="a_Lists">The render list buffer of the renderer.</param>
+			void ExtractRenderList(graphics::dx12::RenderListBuffer& a_Lists);
+
+			/// <summary>
+			/// Fills in the memory and occupancy of the entity bookkeeping and every component pool, with the commands
+			/// that are waiting for the next update. Peak values are sampled once per update, right before pending
+			/// deletions are applied. Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <param name="a_Stats">The stats to fill, its allocations are reused.</param>
+			void GetStats(ECSStats& a_Stats);
+
+			/// <summary>
+			/// Sets the peak values back to the current ones. Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			void ResetPeakStats();
+
+			/// <summary>
+			/// Creates an entity immediately. Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// Use a command buffer to create entities from other places.
+			/// </summary>
+			/// <param name="a_Name">The name of the entity.</param>
+			/// <returns>The handle of the new entity.</returns>
 			EntityID CreateEntity(const std::string& a_Name);
+
+			/// <summary>
+			/// Creates a number of instances of a prefab. Handles are reserved in one go and every pool grows at most once.
+			/// Instances are all named after the prefab. Must be called while holding m_EntityMutex or from the thread that updates the ECS.
+			/// </summary>
+			/// <param name="a_Prefab">The prefab.</param>
+			/// <param name="a_Count">The number of instances.</param>
+			/// <param name="a_Transforms">Optional local transform of every instance. Instances get a transform component if they do not have one yet.</param>
+			/// <returns>The handles of the new entities.</returns>
+			std::vector<EntityID> Instantiate(const Prefab& a_Prefab, size_t a_Count, const graphics::dx12::Transform* a_Transforms = nullptr);
+
+			/// <summary>
+			/// Gives every entity in the list a copy of a component, growing the pool at most once.
+			/// Entities that already have the component keep theirs.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type, stored with one component per entity.</typeparam>
+			/// <param name="a_IDs">The entities.</param>
+			/// <param name="a_Count">The number of entities.</param>
+			/// <param name="a_Component">The component to copy.</param>
+			template <class ComponentType>
+			void CreateComponents(const EntityID* a_IDs, size_t a_Count, const ComponentType& a_Component)
+			{
+				AbstractECSSystem* system = GetComponentPoolOwner(ComponentTypeIndex::Get<ComponentType>(), false);
+				if (!system)
+				{
+					LogMissingComponentSystem();
+					return;
+				}
+				static_cast<ECSBaseSystem<ComponentType>*>(system)->CreateComponents(a_IDs, a_Count, a_Component);
+			}
+
+			/// <summary>
+			/// Deletes an entity at the start of the next update. Safe to call from any thread.
+			/// </summary>
+			/// <param name="a_ID">The entity to delete.</param>
 			void Delete(const EntityID& a_ID);
+
+			/// <summary>
+			/// Retrieves the command buffer of the calling thread. The first call on a thread creates its buffer,
+			/// after that recording does not touch any state shared with other threads.
+			/// </summary>
+			/// <returns>Reference to the command buffer of the calling thread.</returns>
+			EntityCommandBuffer& GetCommandBuffer();
 			bool IsEntityValid(const EntityID& a_ID) const;
 			void Clear();
 
 			std::string GetUniqueName(const std::string& a_Name);
 
+			/// <summary>
+			/// Finds an entity by its name.
+			/// </summary>
+			/// <param name="a_Name">The name to look for.</param>
+			/// <returns>An entity with the name, or an invalid id if no entity has it.</returns>
+			EntityID FindEntityByName(const std::string& a_Name);
+
 			template <class T>
 			T& CreateSystem()
 			{
 				T* system = new T();
+				system->SetChangeTickSource(&m_ChangeTick);
+				system->SetEventBus(&m_Events);
 				m_Systems.push_back(system);
+
+				const size_t systemIndex = SystemTypeIndex::Get<T>();
+				if (systemIndex >= m_SystemsByType.size())
+				{
+					m_SystemsByType.resize(systemIndex + 1, nullptr);
+				}
+				m_SystemsByType[systemIndex] = system;
+
+				RegisterComponentOwner(system);
+
+				m_ScheduleDirty = true;
 				return *system;
 			}
 
+			/// <summary>
+			/// Retrieves the system of the given type, creating it if it does not exist yet.
+			/// Systems are looked up by their exact type.
+			/// </summary>
+			/// <typeparam name="T">The system type.</typeparam>
+			/// <returns>Reference to the system.</returns>
 			template <class T>
 			T& GetSystem()
 			{
-				for (AbstractECSSystem* sys : m_Systems)
+				const size_t index = SystemTypeIndex::Get<T>();
+				if (index < m_SystemsByType.size() && m_SystemsByType[index])
+				{
+					return *static_cast<T*>(m_SystemsByType[index]);
+				}
+				return CreateSystem<T>();
+			};
+
+			/// <summary>
+			/// Retrieves the pool that stores a component type.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Pointer to the pool, or nullptr if no system stores this component type with one component per entity.</returns>
+			template <class ComponentType>
+			ComponentPool<ComponentType>* GetComponentPool()
+			{
+				AbstractECSSystem* system = GetComponentPoolOwner(ComponentTypeIndex::Get<ComponentType>(), false);
+				return system ? &static_cast<ECSBaseSystem<ComponentType>*>(system)->GetComponents() : nullptr;
+			}
+
+			/// <summary>
+			/// Retrieves the pool that stores a component type that entities can have several of.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Pointer to the pool, or nullptr if no system stores this component type with several components per entity.</returns>
+			template <class ComponentType>
+			MultiComponentPool<ComponentType>* GetMultiComponentPool()
+			{
+				AbstractECSSystem* system = GetComponentPoolOwner(ComponentTypeIndex::Get<ComponentType>(), true);
+				return system ? &static_cast<ECSMultiSystem<ComponentType>*>(system)->GetPool() : nullptr;
+			}
+
+			/// <summary>
+			/// Retrieves the tick that components changed right now are stamped with.
+			/// </summary>
+			/// <returns>The current change tick.</returns>
+			uint32_t GetChangeTick() const;
+
+			/// <summary>
+			/// Moves on to the next change tick, so that changes made after this call can be told apart from earlier ones.
+			/// A consumer calls this before it processes changes, handles everything that changed at or after the tick
+			/// it remembered, and remembers the returned value + 1 for the next run.
+			/// </summary>
+			/// <returns>The change tick before advancing.</returns>
+			uint32_t AdvanceChangeTick();
+
+			/// <summary>
+			/// Creates a view over all entities that have every one of the requested components.
+			/// </summary>
+			/// <typeparam name="ComponentTypes">The component types to join. Const types are accessed without marking them as changed.</typeparam>
+			/// <returns>The view.</returns>
+			template <class... ComponentTypes>
+			ComponentView<ComponentTypes...> View()
+			{
+				return ComponentView<ComponentTypes...>(m_Signatures, GetComponentPool<std::remove_const_t<ComponentTypes>>()...);
+			}
+
+			/// <summary>
+			/// Calls the function for every entity whose signature matches a filter. Only the signatures are read,
+			/// so this is the cheapest way to find entities by tags or by which components they have.
+			/// Entities must not be created or deleted while iterating.
+			/// </summary>
+			/// <param name="a_Filter">The component and tag types to require and leave out.</param>
+			/// <param name="a_Func">Function with signature void(const EntityID&).</param>
+			template <class Func>
+			void ForEachEntity(const SignatureFilter& a_Filter, Func&& a_Func)
+			{
+				for (const EntityID& id : m_Entities)
 				{
-					T* result = dynamic_cast<T*>(sys);
-					if (result)
+					if (m_Signatures.Matches(id, a_Filter))
 					{
-						return *result;
+						a_Func(id);
 					}
 				}
-				return CreateSystem<T>();
+			}
+
+			/// <summary>
+			/// Retrieves the component and tag types of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The signature, empty if the entity is not valid.</returns>
+			const ComponentSignature& GetSignature(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Gives an entity a tag. Tags are empty types that only exist in the entity signature, they take no pool and no system.
+			/// Must be called while holding m_EntityMutex or from the thread that updates the ECS. Use a command buffer to tag entities from other places.
+			/// </summary>
+			/// <typeparam name="TagType">The tag type, an empty struct.</typeparam>
+			/// <param name="a_ID">The entity.</param>
+			template <class TagType>
+			void AddTag(const EntityID& a_ID)
+			{
+				static_assert(std::is_empty_v<TagType>, "TagType must be an empty type");
+				SetTag(a_ID, ComponentTypeIndex::Get<TagType>(), true);
+			}
+
+			/// <summary>
+			/// Takes a tag away from an entity. Same threading rules as AddTag.
+			/// </summary>
+			/// <typeparam name="TagType">The tag type, an empty struct.</typeparam>
+			/// <param name="a_ID">The entity.</param>
+			template <class TagType>
+			void RemoveTag(const EntityID& a_ID)
+			{
+				static_assert(std::is_empty_v<TagType>, "TagType must be an empty type");
+				SetTag(a_ID, ComponentTypeIndex::Get<TagType>(), false);
+			}
+
+			template <class TagType>
+			bool HasTag(const EntityID& a_ID) const
+			{
+				static_assert(std::is_empty_v<TagType>, "TagType must be an empty type");
+				return GetSignature(a_ID).Test(ComponentTypeIndex::Get<TagType>());
+			}
+
+			/// <summary>
+			/// Range over the systems that contain a component for an entity. Systems are filtered while
+			/// iterating, so no list is allocated. Systems that own their component type are tested against
+			/// the entity signature, other systems are asked directly.
+			/// </summary>
+			class SystemsContainingEntity
+			{
+			public:
+				class Iterator
+				{
+				public:
+					Iterator(AbstractECSSystem* const* a_Current, AbstractECSSystem* const* a_End, const EntityID& a_ID, const ComponentSignature& a_Signature);
+
+					AbstractECSSystem* operator*() const
+					{
+						return *m_Current;
+					}
+
+					Iterator& operator++();
+
+					bool operator!=(const Iterator& a_Other) const
+					{
+						return m_Current != a_Other.m_Current;
+					}
+
+					bool operator==(const Iterator& a_Other) const
+					{
+						return m_Current == a_Other.m_Current;
+					}
+				private:
+					void SkipToMatch();
+
+					AbstractECSSystem* const* m_Current = nullptr;
+					AbstractECSSystem* const* m_End = nullptr;
+					EntityID m_ID;
+					const ComponentSignature* m_Signature = nullptr;
+				};
+
+				SystemsContainingEntity(const std::vector<AbstractECSSystem*>& a_Systems, const EntityID& a_ID, const ComponentSignature& a_Signature) : m_Systems(a_Systems), m_ID(a_ID), m_Signature(a_Signature)
+				{}
+
+				Iterator begin() const
+				{
+					return Iterator(m_Systems.data(), m_Systems.data() + m_Systems.size(), m_ID, m_Signature);
+				}
+
+				Iterator end() const
+				{
+					AbstractECSSystem* const* last = m_Systems.data() + m_Systems.size();
+					return Iterator(last, last, m_ID, m_Signature);
+				}
+			private:
+				const std::vector<AbstractECSSystem*>& m_Systems;
+				EntityID m_ID;
+				const ComponentSignature& m_Signature;
 			};
 
 			std::vector<EntityID>& GetEntities();
-			std::vector<AbstractECSSystem*> GetSystemsContainingEntity(const EntityID& a_ID);
-			std::vector<AbstractECSSystem*> GetSystems();
+			SystemsContainingEntity GetSystemsContainingEntity(const EntityID& a_ID) const;
+			const std::vector<AbstractECSSystem*>& GetSystems() const;
 
 			std::mutex m_EntityMutex;
 		private:
+			friend class EntityCommandBuffer;
+
+			static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+			/// <summary>
+			/// Hands out the handle of an entity that is created later. Safe to call from any thread.
+			/// </summary>
+			/// <returns>The reserved handle.</returns>
+			EntityID ReserveEntity();
+
+			/// <summary>
+			/// Hands out the handles of a number of entities that are created later. Safe to call from any thread.
+			/// </summary>
+			/// <param name="a_Count">The number of handles.</param>
+			/// <param name="a_IDs">The list the handles are appended to.</param>
+			void ReserveEntities(size_t a_Count, std::vector<EntityID>& a_IDs);
+
+			/// <summary>
+			/// Makes a reserved handle a live entity.
+			/// </summary>
+			/// <param name="a_ID">The reserved handle.</param>
+			/// <param name="a_Name">The name of the entity.</param>
+			void ActivateEntity(const EntityID& a_ID, const std::string& a_Name);
+
+			/// <summary>
+			/// Applies the commands of every thread's command buffer.
+			/// </summary>
+			void ApplyCommandBuffers();
+
+			/// <summary>
+			/// Drops the reserved handles and makes the indices of deleted entities available for reservation.
+			/// </summary>
+			void RefillReservableIDs();
+
 			void DeleteEntity(const EntityID& a_ID);
 			void ClearEntities();
 
+			/// <summary>
+			/// Adds a tag to or removes it from the signature of an entity and records the change as an EntityComponentsChangedEvent.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_TagType">Index of the tag type within ComponentTypeIndex.</param>
+			/// <param name="a_Add">True to add the tag, false to remove it.</param>
+			void SetTag(const EntityID& a_ID, size_t a_TagType, bool a_Add);
+
+			/// <summary>
+			/// Makes a system the owner of the pool of its component type if no other system owns it yet. The owner keeps the
+			/// signatures up to date, unless the type does not fit in a signature.
+			/// </summary>
+			/// <param name="a_System">The system that was just created.</param>
+			void RegisterComponentOwner(AbstractECSSystem* a_System);
+
+			/// <summary>
+			/// Retrieves the system that owns the pool of a component type.
+			/// </summary>
+			/// <param name="a_ComponentIndex">Index of the component type within ComponentTypeIndex.</param>
+			/// <param name="a_Multiple">Whether the pool has to be a MultiComponentPool.</param>
+			/// <returns>The system, or nullptr if no system stores the component type in the requested kind of pool.</returns>
+			AbstractECSSystem* GetComponentPoolOwner(size_t a_ComponentIndex, bool a_Multiple) const;
+			void LogMissingComponentSystem() const;
+
+			/// <summary>
+			/// Raises the peak values to the current entity count and pool sizes.
+			/// </summary>
+			void RecordPeakStats();
+
+			/// <summary>
+			/// Moves the entities whose world matrix or mesh changed in the spatial index, and removes entities that lost their transform.
+			/// </summary>
+			void UpdateSpatialIndex();
+
+			/// <summary>
+			/// Groups the systems into stages. A system is placed in the stage after the last earlier registered
+			/// system it conflicts with, so conflicting systems keep their registration order and systems
+			/// within a stage can be updated at the same time.
+			/// </summary>
+			void BuildSchedule();
+
+			/// <summary>
+			/// Updates every system of a stage, spreading them over the job system.
+			/// </summary>
+			/// <param name="a_Stage">The systems in the stage.</param>
+			/// <param name="a_DeltaTime">The delta time.</param>
+			void UpdateStage(const std::vector<AbstractECSSystem*>& a_Stage, float a_DeltaTime);
+
 			bool m_Clear = false;
+			bool m_SaveEditWorld = false; /// Save the world into m_EditWorld at the next update.
+			bool m_RestoreEditWorld = false; /// Restore m_EditWorld at the next update.
+			WorldSnapshot m_EditWorld; /// The world as it was before play mode started.
 			std::vector<AbstractECSSystem*> m_Systems;
+			std::vector<AbstractECSSystem*> m_SystemsByType; /// Indexed by SystemTypeIndex.
+			std::vector<AbstractECSSystem*> m_SystemsByComponentType; /// Indexed by ComponentTypeIndex.
+			std::vector<std::vector<AbstractECSSystem*>> m_Stages; /// Systems grouped by stage, stages run one after the other.
+			bool m_ScheduleDirty = true;
+
+			struct SystemPeak
+			{
+				size_t m_ComponentCount = 0;
+				size_t m_AllocatedBytes = 0;
+			};
+			std::vector<SystemPeak> m_SystemPeaks; /// Peak values of every system, in registration order.
+			size_t m_PeakEntityCount = 0;
+
 			std::vector<EntityID> m_Entities;
-			std::vector<EntityID> m_EntitiesToDelete;
-			std::vector<EntityID> m_EntitiesToAdd;
-			unsigned int m_NextID = 0;
+
+			std::vector<uint32_t> m_Generations; /// Current generation of every entity index.
+			std::vector<uint32_t> m_EntitySlots; /// Position of every live entity index in m_Entities, INVALID_SLOT if not alive.
+			std::vector<uint32_t> m_PendingFreeIndices; /// Indices of deleted entities whose components have not been removed yet.
+
+			std::vector<EntityID> m_ReservableIDs; /// Recycled handles that ReserveEntity hands out first.
+			std::atomic<size_t> m_ReservedCount{ 0 }; /// Number of reservations since the last refill.
+			std::atomic<uint32_t> m_NextIndex{ 0 }; /// First index that has never been handed out.
+			std::shared_mutex m_ReserveMutex; /// Shared while reserving, exclusive while refilling m_ReservableIDs.
+
+			std::atomic<uint32_t> m_ChangeTick{ 1 }; /// Tick that changed components are stamped with.
+
+			EntitySignatures m_Signatures; /// Component and tag types of every entity.
+
+			uint64_t m_RenderFrame = 0; /// Number of render lists extracted so far.
+
+			SpatialIndex m_SpatialIndex;
+			uint32_t m_SpatialLayoutVersion = 0; /// Transform cache layout the spatial index was last checked against.
+
+			ECSEventBus m_Events;
+			EventQueue<EntityCreatedEvent>* m_CreatedEvents = nullptr;
+			EventQueue<EntityDestroyedEvent>* m_DestroyedEvents = nullptr;
+
+			std::vector<std::unique_ptr<EntityCommandBuffer>> m_CommandBuffers; /// One buffer for every thread that recorded commands.
+			std::mutex m_CommandBufferMutex; /// Guards m_CommandBuffers, only taken when a thread gets its first buffer.
 			bool m_Paused = false;
-#ifdef __EDITOR__
+#ifdef _EDITOR
 			bool m_Started = false;
 #else
 			bool m_Started = true;
-#endif // __EDITOR__
+#endif // _EDITOR
 		};
 	}
 }
\ No newline at end of file
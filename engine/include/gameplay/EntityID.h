@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace gallus
@@ -8,9 +9,13 @@ namespace gallus
 	{
 		class TransformComponent;
 
+		/// <summary>
+		/// Handle to an entity. The index addresses the entity's slot and is recycled after the entity is deleted,
+		/// the generation is bumped on every delete so handles to a previous occupant of the slot can be detected.
+		/// </summary>
 		struct EntityID
 		{
-			EntityID(unsigned int a_ID) : m_ID(a_ID)
+			EntityID(uint32_t a_Index, uint32_t a_Generation) : m_Index(a_Index), m_Generation(a_Generation)
 			{};
 			EntityID()
 			{};
@@ -18,38 +23,45 @@ namespace gallus
 
 			bool IsValid() const
 			{
-				return m_ID != INVALID;
+				return m_Generation != INVALID;
 			};
 			void SetInvalid()
 			{
-				m_ID = INVALID;
+				m_Index = 0;
+				m_Generation = INVALID;
 			}
 
-			unsigned int GetID() const
+			uint32_t GetIndex() const
 			{
-				return m_ID;
+				return m_Index;
+			}
+
+			uint32_t GetGeneration() const
+			{
+				return m_Generation;
 			}
 
 			bool operator==(const EntityID& a_Other) const
 			{
-				return m_ID == a_Other.m_ID;
+				return m_Index == a_Other.m_Index && m_Generation == a_Other.m_Generation;
 			}
 
 			bool operator!=(const EntityID& a_Other) const
 			{
-				return m_ID != a_Other.m_ID;
+				return !(*this == a_Other);
 			}
 
 			bool operator<(const EntityID& a_Other) const
 			{
-				return m_ID < a_Other.m_ID;
+				return m_Index != a_Other.m_Index ? m_Index < a_Other.m_Index : m_Generation < a_Other.m_Generation;
 			}
 		protected:
-			enum ID_State : unsigned int
+			enum ID_State : uint32_t
 			{
 				INVALID = 0
 			};
-			unsigned int m_ID = INVALID;
+			uint32_t m_Index = 0;
+			uint32_t m_Generation = INVALID;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Storage for components of a single type where an entity can own any number of them. The components of an
+		/// entity are kept next to each other in one dense array and a sparse entity-to-range table points at them,
+		/// so all components of an entity are found in constant time.
+		/// Adding to an entity whose range is not at the end of the array moves the range to the end. Removing
+		/// leaves gaps as well; gaps are skipped while iterating and closed by Compact.
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component stored in the pool.</typeparam>
+		template <class ComponentType>
+		class MultiComponentPool
+		{
+		public:
+			struct Range
+			{
+				uint32_t m_Begin = 0; /// First slot of the range.
+				uint32_t m_Count = 0; /// Number of components in the range.
+			};
+
+			/// <summary>
+			/// Checks whether the entity has at least one component in the pool.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>True if the entity has components in this pool, otherwise false.</returns>
+			bool Contains(const EntityID& a_ID) const
+			{
+				return GetRange(a_ID).m_Count != 0;
+			}
+
+			/// <summary>
+			/// Retrieves the slots of the entity's components.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>The range, empty if the entity has no components in this pool.</returns>
+			Range GetRange(const EntityID& a_ID) const
+			{
+				const uint32_t index = a_ID.GetIndex();
+				if (index >= m_Ranges.size())
+				{
+					return {};
+				}
+
+				// The range table is indexed without the generation, so make sure the range is not owned by an earlier occupant of the index.
+				const Range range = m_Ranges[index];
+				if (range.m_Count == 0 || m_Entities[range.m_Begin] != a_ID)
+				{
+					return {};
+				}
+				return range;
+			}
+
+			/// <summary>
+			/// Retrieves the number of components of the entity.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>The number of components.</returns>
+			size_t Count(const EntityID& a_ID) const
+			{
+				return GetRange(a_ID).m_Count;
+			}
+
+			/// <summary>
+			/// Retrieves all components of the entity, in the order they were added.
+			/// The span is invalidated by adding, removing and compacting.
+			/// </summary>
+			/// <param name="a_ID">The entity to look up.</param>
+			/// <returns>The components, empty if the entity has none.</returns>
+			std::span<ComponentType> Get(const EntityID& a_ID)
+			{
+				const Range range = GetRange(a_ID);
+				for (uint32_t slot = range.m_Begin; slot < range.m_Begin + range.m_Count; slot++)
+				{
+					MarkChanged(slot);
+				}
+				return std::span<ComponentType>(m_Components.data() + range.m_Begin, range.m_Count);
+			}
+
+			std::span<const ComponentType> Get(const EntityID& a_ID) const
+			{
+				const Range range = GetRange(a_ID);
+				return std::span<const ComponentType>(m_Components.data() + range.m_Begin, range.m_Count);
+			}
+
+			/// <summary>
+			/// Adds a default constructed component to the end of the entity's components.
+			/// </summary>
+			/// <param name="a_ID">The entity that owns the component.</param>
+			/// <returns>Reference to the new component.</returns>
+			ComponentType& Add(const EntityID& a_ID)
+			{
+				const uint32_t index = a_ID.GetIndex();
+				if (index >= m_Ranges.size())
+				{
+					m_Ranges.resize(static_cast<size_t>(index) + 1);
+				}
+
+				Range& range = m_Ranges[index];
+				if (range.m_Count == 0)
+				{
+					range.m_Begin = static_cast<uint32_t>(m_Components.size());
+				}
+				else if (range.m_Begin + range.m_Count != m_Components.size())
+				{
+					// Indices are only recycled after all components of the previous occupant have been removed.
+					assert(m_Entities[range.m_Begin] == a_ID);
+
+					// The range can not grow in place, so it moves to the end and leaves a gap behind.
+					const uint32_t begin = static_cast<uint32_t>(m_Components.size());
+					Grow(m_Components.size() + range.m_Count + 1);
+					for (uint32_t i = 0; i < range.m_Count; i++)
+					{
+						const uint32_t slot = range.m_Begin + i;
+						m_Components.push_back(std::move(m_Components[slot]));
+						m_Entities.push_back(a_ID);
+						m_Versions.push_back(m_Versions[slot]);
+						m_Entities[slot] = EntityID();
+					}
+					m_GapCount += range.m_Count;
+					range.m_Begin = begin;
+				}
+
+				Grow(m_Components.size() + 1);
+				m_Entities.push_back(a_ID);
+				m_Versions.push_back(GetChangeTick());
+				range.m_Count++;
+				return m_Components.emplace_back();
+			}
+
+			/// <summary>
+			/// Removes one component of the entity. The components after it keep their order.
+			/// </summary>
+			/// <param name="a_ID">The entity whose component gets removed.</param>
+			/// <param name="a_Instance">Position of the component within the entity's components.</param>
+			/// <returns>True if a component was removed, otherwise false.</returns>
+			bool Remove(const EntityID& a_ID, size_t a_Instance)
+			{
+				const Range range = GetRange(a_ID);
+				if (a_Instance >= range.m_Count)
+				{
+					return false;
+				}
+
+				const uint32_t last = range.m_Begin + range.m_Count - 1;
+				for (uint32_t slot = range.m_Begin + static_cast<uint32_t>(a_Instance); slot < last; slot++)
+				{
+					m_Components[slot] = std::move(m_Components[slot + 1]);
+					m_Versions[slot] = m_Versions[slot + 1];
+				}
+				ReleaseSlot(last);
+				m_Ranges[a_ID.GetIndex()].m_Count--;
+				return true;
+			}
+
+			/// <summary>
+			/// Removes all components of the entity.
+			/// </summary>
+			/// <param name="a_ID">The entity whose components get removed.</param>
+			/// <returns>True if components were removed, otherwise false.</returns>
+			bool RemoveAll(const EntityID& a_ID)
+			{
+				const Range range = GetRange(a_ID);
+				if (range.m_Count == 0)
+				{
+					return false;
+				}
+
+				for (uint32_t slot = range.m_Begin + range.m_Count; slot-- > range.m_Begin;)
+				{
+					ReleaseSlot(slot);
+				}
+				m_Ranges[a_ID.GetIndex()].m_Count = 0;
+				return true;
+			}
+
+			/// <summary>
+			/// Closes the gaps left by adding and removing, keeping the order of the remaining components.
+			/// </summary>
+			void Compact()
+			{
+				if (m_GapCount == 0)
+				{
+					return;
+				}
+
+				uint32_t write = 0;
+				for (uint32_t slot = 0; slot < m_Components.size(); slot++)
+				{
+					const EntityID id = m_Entities[slot];
+					if (!id.IsValid())
+					{
+						continue;
+					}
+
+					Range& range = m_Ranges[id.GetIndex()];
+					if (range.m_Begin == slot)
+					{
+						range.m_Begin = write;
+					}
+					if (write != slot)
+					{
+						m_Components[write] = std::move(m_Components[slot]);
+						m_Entities[write] = id;
+						m_Versions[write] = m_Versions[slot];
+					}
+					write++;
+				}
+
+				m_Components.erase(m_Components.begin() + write, m_Components.end());
+				m_Entities.resize(write);
+				m_Versions.resize(write);
+				m_GapCount = 0;
+			}
+
+			/// <summary>
+			/// Calls the function for every component, grouped by entity.
+			/// </summary>
+			/// <param name="a_Func">Function with signature void(const EntityID&, ComponentType&).</param>
+			template <class Func>
+			void ForEach(Func&& a_Func)
+			{
+				for (size_t slot = 0; slot < m_Components.size(); slot++)
+				{
+					if (m_Entities[slot].IsValid())
+					{
+						MarkChanged(slot);
+						a_Func(m_Entities[slot], m_Components[slot]);
+					}
+				}
+			}
+
+			template <class Func>
+			void ForEach(Func&& a_Func) const
+			{
+				for (size_t slot = 0; slot < m_Components.size(); slot++)
+				{
+					if (m_Entities[slot].IsValid())
+					{
+						a_Func(m_Entities[slot], m_Components[slot]);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Replaces the contents of the pool with a copy of another pool. The change tick source is not copied.
+			/// </summary>
+			/// <param name="a_Other">The pool to copy.</param>
+			void CopyFrom(const MultiComponentPool& a_Other)
+			{
+				m_Components = a_Other.m_Components;
+				m_Entities = a_Other.m_Entities;
+				m_Versions = a_Other.m_Versions;
+				m_Ranges = a_Other.m_Ranges;
+				m_GapCount = a_Other.m_GapCount;
+			}
+
+			/// <summary>
+			/// Reserves room for a number of slots so that adding does not reallocate.
+			/// </summary>
+			/// <param name="a_Size">The number of slots to reserve room for.</param>
+			void Reserve(size_t a_Size)
+			{
+				m_Components.reserve(a_Size);
+				m_Entities.reserve(a_Size);
+				m_Versions.reserve(a_Size);
+			}
+
+			/// <summary>
+			/// Removes all components from the pool.
+			/// </summary>
+			void Clear()
+			{
+				m_Components.clear();
+				m_Entities.clear();
+				m_Versions.clear();
+				m_Ranges.clear();
+				m_GapCount = 0;
+			}
+
+			/// <summary>
+			/// Retrieves the number of components in the pool, not counting gaps.
+			/// </summary>
+			/// <returns>The number of components.</returns>
+			size_t size() const
+			{
+				return m_Components.size() - m_GapCount;
+			}
+
+			bool empty() const
+			{
+				return size() == 0;
+			}
+
+			/// <summary>
+			/// Retrieves the number of slots in the dense array, including gaps.
+			/// </summary>
+			/// <returns>The number of slots.</returns>
+			size_t GetSlotCount() const
+			{
+				return m_Components.size();
+			}
+
+			/// <summary>
+			/// Retrieves the entity that owns the component in a dense slot.
+			/// </summary>
+			/// <param name="a_Slot">The dense slot.</param>
+			/// <returns>The owning entity, or an invalid id if the slot is a gap.</returns>
+			const EntityID& GetEntity(size_t a_Slot) const
+			{
+				return m_Entities[a_Slot];
+			}
+
+			/// <summary>
+			/// Retrieves the number of slots the pool can hold without reallocating.
+			/// </summary>
+			/// <returns>The capacity of the dense arrays.</returns>
+			size_t GetCapacity() const
+			{
+				return m_Components.capacity();
+			}
+
+			/// <summary>
+			/// Retrieves the size of the entity-to-range table, which grows with the highest entity index that ever had a component.
+			/// </summary>
+			/// <returns>The number of entries.</returns>
+			size_t GetSparseSize() const
+			{
+				return m_Ranges.size();
+			}
+
+			/// <summary>
+			/// Retrieves the number of bytes allocated by the pool.
+			/// </summary>
+			/// <returns>The bytes allocated for the dense arrays and the entity-to-range table.</returns>
+			size_t GetAllocatedBytes() const
+			{
+				return m_Components.capacity() * sizeof(ComponentType) + m_Entities.capacity() * sizeof(EntityID) + m_Versions.capacity() * sizeof(uint32_t) + m_Ranges.capacity() * sizeof(Range);
+			}
+
+			/// <summary>
+			/// Retrieves the number of bytes used by the components, gaps excluded.
+			/// </summary>
+			/// <returns>The bytes of the dense entries that hold a component.</returns>
+			size_t GetLiveBytes() const
+			{
+				return size() * (sizeof(ComponentType) + sizeof(EntityID) + sizeof(uint32_t));
+			}
+
+			void SetChangeTickSource(const std::atomic<uint32_t>* a_ChangeTick)
+			{
+				m_ChangeTick = a_ChangeTick;
+			}
+
+			uint32_t GetChangeTick() const
+			{
+				return m_ChangeTick ? m_ChangeTick->load(std::memory_order_relaxed) : 1;
+			}
+
+			uint32_t GetVersion(size_t a_Slot) const
+			{
+				return m_Versions[a_Slot];
+			}
+
+			void MarkChanged(size_t a_Slot)
+			{
+				m_Versions[a_Slot] = GetChangeTick();
+			}
+
+			ComponentType& operator[](size_t a_Slot)
+			{
+				MarkChanged(a_Slot);
+				return m_Components[a_Slot];
+			}
+
+			const ComponentType& operator[](size_t a_Slot) const
+			{
+				return m_Components[a_Slot];
+			}
+		private:
+			/// <summary>
+			/// Makes sure the arrays can hold a number of slots, growing geometrically.
+			/// </summary>
+			/// <param name="a_Size">The number of slots needed.</param>
+			void Grow(size_t a_Size)
+			{
+				if (a_Size > m_Components.capacity())
+				{
+					Reserve(std::max(a_Size, m_Components.capacity() * 2));
+				}
+			}
+
+			/// <summary>
+			/// Frees a slot, dropping it from the array if it is the last one and turning it into a gap otherwise.
+			/// </summary>
+			/// <param name="a_Slot">The slot to free.</param>
+			void ReleaseSlot(uint32_t a_Slot)
+			{
+				if (a_Slot + 1 == m_Components.size())
+				{
+					m_Components.pop_back();
+					m_Entities.pop_back();
+					m_Versions.pop_back();
+					return;
+				}
+				m_Entities[a_Slot] = EntityID();
+				m_GapCount++;
+			}
+
+			std::vector<ComponentType> m_Components; /// Components, grouped by entity.
+			std::vector<EntityID> m_Entities; /// Owner of each dense slot, invalid for gaps.
+			std::vector<uint32_t> m_Versions; /// Change tick of every dense slot.
+			std::vector<Range> m_Ranges; /// Entity index to the range of its components.
+			size_t m_GapCount = 0; /// Number of slots that do not hold a component.
+			const std::atomic<uint32_t>* m_ChangeTick = nullptr; /// Source of the change tick, 1 is used when not set.
+		};
+	}
+}
\ No newline at end of file
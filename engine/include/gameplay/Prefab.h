@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+#include "gameplay/TypeIndex.h"
+#include "gameplay/EntityComponentSystem.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Template for a group of components that is instantiated many times. Every component type is stored once
+		/// as a ready-made component, so instantiating only copies them into the pools (see EntityComponentSystem::Instantiate).
+		/// </summary>
+		class Prefab
+		{
+		public:
+			Prefab() = default;
+			Prefab(const std::string& a_Name) : m_Name(a_Name)
+			{}
+
+			/// <summary>
+			/// Retrieves the name every instance gets.
+			/// </summary>
+			/// <returns>The name.</returns>
+			const std::string& GetName() const
+			{
+				return m_Name;
+			}
+
+			void SetName(const std::string& a_Name)
+			{
+				m_Name = a_Name;
+			}
+
+			/// <summary>
+			/// Adds a component to the prefab, or retrieves it if the prefab already has one of the type.
+			/// The name of an EntityInfoComponent is ignored, instances are named after the prefab.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Reference to the component every instance gets a copy of.</returns>
+			template <class ComponentType>
+			ComponentType& AddComponent()
+			{
+				if (ComponentType* component = GetComponent<ComponentType>())
+				{
+					return *component;
+				}
+
+				std::unique_ptr<Blueprint<ComponentType>> blueprint = std::make_unique<Blueprint<ComponentType>>();
+				ComponentType& component = blueprint->m_Component;
+				m_Blueprints.push_back(std::move(blueprint));
+				return component;
+			}
+
+			/// <summary>
+			/// Retrieves a component of the prefab.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Pointer to the component, or nullptr if the prefab does not have one of the type.</returns>
+			template <class ComponentType>
+			ComponentType* GetComponent()
+			{
+				return const_cast<ComponentType*>(static_cast<const Prefab*>(this)->GetComponent<ComponentType>());
+			}
+
+			template <class ComponentType>
+			const ComponentType* GetComponent() const
+			{
+				const size_t index = ComponentTypeIndex::Get<ComponentType>();
+				for (const std::unique_ptr<AbstractBlueprint>& blueprint : m_Blueprints)
+				{
+					if (blueprint->GetComponentTypeIndex() == index)
+					{
+						return &static_cast<const Blueprint<ComponentType>*>(blueprint.get())->m_Component;
+					}
+				}
+				return nullptr;
+			}
+
+			/// <summary>
+			/// Copies every component of the prefab to a list of entities, one pool at a time.
+			/// </summary>
+			/// <param name="a_ECS">The ECS the entities live in.</param>
+			/// <param name="a_IDs">The entities.</param>
+			/// <param name="a_Count">The number of entities.</param>
+			void CreateComponents(EntityComponentSystem& a_ECS, const EntityID* a_IDs, size_t a_Count) const;
+		private:
+			class AbstractBlueprint
+			{
+			public:
+				virtual ~AbstractBlueprint() = default;
+
+				virtual size_t GetComponentTypeIndex() const = 0;
+				virtual void CreateComponents(EntityComponentSystem& a_ECS, const EntityID* a_IDs, size_t a_Count) const = 0;
+			};
+
+			template <class ComponentType>
+			class Blueprint : public AbstractBlueprint
+			{
+			public:
+				size_t GetComponentTypeIndex() const override
+				{
+					return ComponentTypeIndex::Get<ComponentType>();
+				}
+
+				void CreateComponents(EntityComponentSystem& a_ECS, const EntityID* a_IDs, size_t a_Count) const override
+				{
+					a_ECS.CreateComponents(a_IDs, a_Count, m_Component);
+				}
+
+				ComponentType m_Component;
+			};
+
+			std::string m_Name;
+			std::vector<std::unique_ptr<AbstractBlueprint>> m_Blueprints;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		class ReserveDataStream;
+	}
+	namespace gameplay
+	{
+		class EntityComponentSystem;
+
+		/*
+			Binary snapshot layout (little endian):
+			- SnapshotHeader
+			- One block per system that supports snapshots, every column inside a block starts on a SNAPSHOT_ALIGNMENT boundary.
+			- Block directory: SnapshotHeader::m_BlockCount SnapshotBlock entries at SnapshotHeader::m_DirectoryOffset.
+			Entities are referred to by their ordinal in the snapshot, UINT32_MAX meaning no entity.
+		*/
+
+		constexpr uint32_t SNAPSHOT_MAGIC = 0x504E5347; // "GSNP"
+		constexpr uint32_t SNAPSHOT_VERSION = 1;
+		constexpr size_t SNAPSHOT_ALIGNMENT = 16;
+		constexpr uint32_t SNAPSHOT_NO_ENTITY = UINT32_MAX;
+
+		struct SnapshotHeader
+		{
+			uint32_t m_Magic = SNAPSHOT_MAGIC;
+			uint32_t m_Version = SNAPSHOT_VERSION;
+			uint32_t m_EntityCount = 0;
+			uint32_t m_BlockCount = 0;
+			uint64_t m_DirectoryOffset = 0;
+		};
+
+		struct SnapshotBlock
+		{
+			char m_Name[32] = {}; /// Property name of the system that wrote the block.
+			uint32_t m_Count = 0; /// Number of components in the block.
+			uint32_t m_Padding = 0;
+			uint64_t m_Offset = 0; /// Offset of the block from the start of the snapshot.
+			uint64_t m_Size = 0; /// Size of the block in bytes.
+		};
+
+		/// <summary>
+		/// Writes the columns of a block. Used by systems in AbstractECSSystem::WriteSnapshot.
+		/// </summary>
+		class SnapshotWriter
+		{
+		public:
+			SnapshotWriter(core::ReserveDataStream& a_Stream, const std::vector<EntityID>& a_Entities, const std::vector<uint32_t>& a_Ordinals) : m_Stream(a_Stream), m_Entities(a_Entities), m_Ordinals(a_Ordinals)
+			{}
+
+			/// <summary>
+			/// Retrieves the ordinal of an entity in the snapshot.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The ordinal, or SNAPSHOT_NO_ENTITY if the entity is not part of the snapshot.</returns>
+			uint32_t GetOrdinal(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Writes the ordinals of a list of entities as a column.
+			/// </summary>
+			/// <param name="a_Entities">The entities.</param>
+			void WriteEntities(const std::vector<EntityID>& a_Entities);
+
+			/// <summary>
+			/// Writes a column of plain data.
+			/// </summary>
+			/// <param name="a_Data">The first element.</param>
+			/// <param name="a_Count">The number of elements.</param>
+			template <class T>
+			void WriteColumn(const T* a_Data, size_t a_Count)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Snapshot columns must be trivially copyable");
+				WriteBytes(a_Data, sizeof(T) * a_Count);
+			}
+
+			/// <summary>
+			/// Writes a column of raw bytes.
+			/// </summary>
+			/// <param name="a_Data">The data.</param>
+			/// <param name="a_Size">The size in bytes.</param>
+			void WriteBytes(const void* a_Data, size_t a_Size);
+		private:
+			core::ReserveDataStream& m_Stream;
+			const std::vector<EntityID>& m_Entities; /// Ordinal to entity.
+			const std::vector<uint32_t>& m_Ordinals; /// Entity index to ordinal.
+		};
+
+		/// <summary>
+		/// Reads the columns of a block straight from the snapshot memory. Used by systems in AbstractECSSystem::ReadSnapshot.
+		/// </summary>
+		class SnapshotReader
+		{
+		public:
+			SnapshotReader(const unsigned char* a_Begin, const unsigned char* a_End, const std::vector<EntityID>& a_Entities) : m_Current(a_Begin), m_End(a_End), m_Entities(a_Entities)
+			{}
+
+			/// <summary>
+			/// Retrieves the entity that was created for an ordinal.
+			/// </summary>
+			/// <param name="a_Ordinal">The ordinal.</param>
+			/// <returns>The entity, or an invalid id for SNAPSHOT_NO_ENTITY and out of range ordinals.</returns>
+			EntityID GetEntity(uint32_t a_Ordinal) const
+			{
+				return a_Ordinal < m_Entities.size() ? m_Entities[a_Ordinal] : EntityID();
+			}
+
+			/// <summary>
+			/// Reads a column of plain data without copying it.
+			/// </summary>
+			/// <param name="a_Count">The number of elements.</param>
+			/// <returns>Pointer to the first element, or nullptr if the block is too small.</returns>
+			template <class T>
+			const T* ReadColumn(size_t a_Count)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Snapshot columns must be trivially copyable");
+				static_assert(alignof(T) <= SNAPSHOT_ALIGNMENT, "Snapshot columns can not be aligned beyond SNAPSHOT_ALIGNMENT");
+				return reinterpret_cast<const T*>(ReadBytes(sizeof(T) * a_Count));
+			}
+
+			/// <summary>
+			/// Reads a column of raw bytes without copying it.
+			/// </summary>
+			/// <param name="a_Size">The size in bytes.</param>
+			/// <returns>Pointer to the data, or nullptr if the block is too small.</returns>
+			const unsigned char* ReadBytes(size_t a_Size);
+		private:
+			const unsigned char* m_Current = nullptr;
+			const unsigned char* m_End = nullptr;
+			const std::vector<EntityID>& m_Entities; /// Ordinal to created entity.
+		};
+
+		/// <summary>
+		/// Saves and loads the world as a binary snapshot. Every system that implements WriteSnapshot/ReadSnapshot gets a block.
+		/// The snapshot is read in place, so it can be loaded straight from a memory mapped file.
+		/// </summary>
+		class SceneSnapshot
+		{
+		public:
+			/// <summary>
+			/// Writes all entities and the components of every system that supports snapshots.
+			/// </summary>
+			/// <param name="a_ECS">The world to save.</param>
+			/// <param name="a_Stream">The stream to write to.</param>
+			/// <returns>True if the snapshot was written, otherwise false.</returns>
+			static bool Save(EntityComponentSystem& a_ECS, core::ReserveDataStream& a_Stream);
+
+			/// <summary>
+			/// Creates the entities of a snapshot and their components. The entities are added to the world, existing
+			/// entities are left alone. Must be called from the thread that updates the ECS or while holding m_EntityMutex.
+			/// </summary>
+			/// <param name="a_ECS">The world to load into.</param>
+			/// <param name="a_Data">The snapshot, aligned to at least SNAPSHOT_ALIGNMENT bytes.</param>
+			/// <param name="a_Size">The size of the snapshot in bytes.</param>
+			/// <returns>True if the snapshot was loaded, otherwise false.</returns>
+			static bool Load(EntityComponentSystem& a_ECS, const void* a_Data, size_t a_Size);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,469 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Axis aligned bounding box.
+		/// </summary>
+		struct Bounds
+		{
+			DirectX::XMFLOAT3 m_Min;
+			DirectX::XMFLOAT3 m_Max;
+
+			bool Contains(const Bounds& a_Other) const
+			{
+				return m_Min.x <= a_Other.m_Min.x && m_Min.y <= a_Other.m_Min.y && m_Min.z <= a_Other.m_Min.z &&
+					m_Max.x >= a_Other.m_Max.x && m_Max.y >= a_Other.m_Max.y && m_Max.z >= a_Other.m_Max.z;
+			}
+
+			bool Overlaps(const Bounds& a_Other) const
+			{
+				return m_Min.x <= a_Other.m_Max.x && m_Min.y <= a_Other.m_Max.y && m_Min.z <= a_Other.m_Max.z &&
+					m_Max.x >= a_Other.m_Min.x && m_Max.y >= a_Other.m_Min.y && m_Max.z >= a_Other.m_Min.z;
+			}
+
+			Bounds Merge(const Bounds& a_Other) const
+			{
+				return {
+					{ std::min(m_Min.x, a_Other.m_Min.x), std::min(m_Min.y, a_Other.m_Min.y), std::min(m_Min.z, a_Other.m_Min.z) },
+					{ std::max(m_Max.x, a_Other.m_Max.x), std::max(m_Max.y, a_Other.m_Max.y), std::max(m_Max.z, a_Other.m_Max.z) }
+				};
+			}
+
+			/// <summary>
+			/// Retrieves half the surface area, the cost measure used to decide where entries go in the tree.
+			/// </summary>
+			/// <returns>Half the surface area.</returns>
+			float GetHalfArea() const
+			{
+				const float x = m_Max.x - m_Min.x;
+				const float y = m_Max.y - m_Min.y;
+				const float z = m_Max.z - m_Min.z;
+				return x * y + y * z + z * x;
+			}
+
+			/// <summary>
+			/// Computes the bounds that enclose a box after it is transformed.
+			/// </summary>
+			/// <param name="a_Local">The box in local space.</param>
+			/// <param name="a_World">The world matrix.</param>
+			/// <returns>The bounds in world space.</returns>
+			static Bounds Transform(const Bounds& a_Local, const DirectX::XMFLOAT4X4& a_World);
+		};
+
+		/// <summary>
+		/// The six planes of a view frustum. Plane normals point inwards, so points inside have a positive distance to every plane.
+		/// </summary>
+		struct Frustum
+		{
+			DirectX::XMFLOAT4 m_Planes[6];
+
+			/// <summary>
+			/// Extracts the planes of a view and projection matrix.
+			/// </summary>
+			/// <param name="a_ViewProjection">The view matrix multiplied by the projection matrix.</param>
+			/// <returns>The frustum.</returns>
+			static Frustum FromViewProjection(const DirectX::XMMATRIX& a_ViewProjection);
+		};
+
+		/// <summary>
+		/// Half line used by the ray queries. Distances are measured in multiples of the direction.
+		/// </summary>
+		struct Ray
+		{
+			DirectX::XMFLOAT3 m_Origin;
+			DirectX::XMFLOAT3 m_Direction;
+		};
+
+		struct RaycastHit
+		{
+			EntityID m_ID;
+			float m_Distance = 0.0f; /// Distance at which the ray enters the bounds of the entity.
+		};
+
+		/// <summary>
+		/// Dynamic bounding volume hierarchy over entity bounds. Every entity is a leaf with slightly enlarged bounds, so an
+		/// entity that moves a little only updates its own entry and is moved through the tree once it leaves the enlarged bounds.
+		/// Branches are kept balanced with tree rotations. Updates can be batched, in which case the tree is rebuilt in one go
+		/// when most entities have to move through it. Queries test the exact bounds of the entities.
+		/// </summary>
+		class SpatialIndex
+		{
+		public:
+			/// <summary>
+			/// Adds an entity or moves it to new bounds.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_Bounds">The bounds of the entity in world space.</param>
+			/// <returns>True if the entity has to be inserted into the tree, false if only its entry was updated.</returns>
+			bool Update(const EntityID& a_ID, const Bounds& a_Bounds);
+
+			/// <summary>
+			/// Starts a batch of updates. Entities that have to be inserted into the tree are collected and inserted by EndUpdate,
+			/// which rebuilds the whole tree instead if that is cheaper. The index must not be queried until the batch has ended.
+			/// </summary>
+			void BeginUpdate();
+
+			/// <summary>
+			/// Inserts the entities collected since BeginUpdate.
+			/// </summary>
+			void EndUpdate();
+
+			/// <summary>
+			/// Removes an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>True if the entity was in the index, otherwise false.</returns>
+			bool Remove(const EntityID& a_ID);
+
+			/// <summary>
+			/// Removes all entities.
+			/// </summary>
+			void Clear();
+
+			/// <summary>
+			/// Rebuilds the whole tree from its entities, which gives a better tree than inserting them one by one.
+			/// </summary>
+			void Rebuild();
+
+			bool Contains(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Retrieves the bounds an entity was last updated with.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>Pointer to the bounds, or nullptr if the entity is not in the index.</returns>
+			const Bounds* GetBounds(const EntityID& a_ID) const;
+
+			size_t size() const
+			{
+				return m_LeafCount;
+			}
+
+			/// <summary>
+			/// Sets how far the bounds of an entity are enlarged in the tree. A larger margin means fewer moves through the
+			/// tree for moving entities, but more branches to visit for queries.
+			/// </summary>
+			/// <param name="a_Margin">The margin in world units.</param>
+			void SetMargin(float a_Margin)
+			{
+				m_Margin = a_Margin;
+			}
+
+			float GetMargin() const
+			{
+				return m_Margin;
+			}
+
+			/// <summary>
+			/// Retrieves the number of levels of the tree.
+			/// </summary>
+			/// <returns>The height, 0 if the index is empty.</returns>
+			uint32_t GetHeight() const;
+
+			size_t GetAllocatedBytes() const
+			{
+				return m_Nodes.capacity() * sizeof(Node) + m_Leaves.capacity() * sizeof(uint32_t) + m_Pending.capacity() * sizeof(uint32_t);
+			}
+
+			/// <summary>
+			/// Calls a function for every entity in the index.
+			/// </summary>
+			/// <param name="a_Func">Function taking the entity and its bounds.</param>
+			template <class Func>
+			void ForEach(Func&& a_Func) const
+			{
+				for (const Node& node : m_Nodes)
+				{
+					if (node.IsLeaf())
+					{
+						a_Func(node.m_ID, node.m_Tight);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Calls a function for every entity whose bounds overlap a box.
+			/// </summary>
+			/// <param name="a_Bounds">The box.</param>
+			/// <param name="a_Func">Function taking the entity.</param>
+			template <class Func>
+			void QueryBounds(const Bounds& a_Bounds, Func&& a_Func) const
+			{
+				Traverse([&a_Bounds](const Bounds& a_NodeBounds)
+				{
+					return a_NodeBounds.Overlaps(a_Bounds);
+				}, a_Func);
+			}
+
+			/// <summary>
+			/// Calls a function for every entity whose bounds overlap a sphere.
+			/// </summary>
+			/// <param name="a_Center">The center of the sphere.</param>
+			/// <param name="a_Radius">The radius of the sphere.</param>
+			/// <param name="a_Func">Function taking the entity.</param>
+			template <class Func>
+			void QuerySphere(const DirectX::XMFLOAT3& a_Center, float a_Radius, Func&& a_Func) const
+			{
+				const float radiusSq = a_Radius * a_Radius;
+				Traverse([&a_Center, radiusSq](const Bounds& a_NodeBounds)
+				{
+					return GetDistanceSq(a_NodeBounds, a_Center) <= radiusSq;
+				}, a_Func);
+			}
+
+			/// <summary>
+			/// Calls a function for every entity whose bounds are at least partially inside a frustum. Entities are
+			/// culled conservatively, bounds near a corner of the frustum can be reported while they are just outside.
+			/// </summary>
+			/// <param name="a_Frustum">The frustum.</param>
+			/// <param name="a_Func">Function taking the entity.</param>
+			template <class Func>
+			void QueryFrustum(const Frustum& a_Frustum, Func&& a_Func) const
+			{
+				if (m_Root == INVALID_NODE)
+				{
+					return;
+				}
+
+				// Branches that are completely inside are reported without testing anything below them.
+				constexpr uint32_t INSIDE = 0x80000000u;
+				TraversalStack stack;
+				stack.Push(m_Root);
+				while (!stack.IsEmpty())
+				{
+					const uint32_t entry = stack.Pop();
+					const Node& node = m_Nodes[entry & ~INSIDE];
+					bool inside = (entry & INSIDE) != 0;
+					if (!inside)
+					{
+						const FrustumResult result = Classify(a_Frustum, node.IsLeaf() ? node.m_Tight : node.m_Bounds);
+						if (result == FrustumResult::Outside)
+						{
+							continue;
+						}
+						inside = result == FrustumResult::Inside;
+					}
+
+					if (node.IsLeaf())
+					{
+						a_Func(node.m_ID);
+						continue;
+					}
+					stack.Push(node.m_Left | (inside ? INSIDE : 0));
+					stack.Push(node.m_Right | (inside ? INSIDE : 0));
+				}
+			}
+
+			/// <summary>
+			/// Calls a function for every entity whose bounds are hit by a ray, in no particular order.
+			/// </summary>
+			/// <param name="a_Ray">The ray.</param>
+			/// <param name="a_MaxDistance">Hits further away than this are ignored.</param>
+			/// <param name="a_Func">Function taking the entity and the distance at which the ray enters its bounds.</param>
+			template <class Func>
+			void Raycast(const Ray& a_Ray, float a_MaxDistance, Func&& a_Func) const
+			{
+				if (m_Root == INVALID_NODE)
+				{
+					return;
+				}
+
+				const DirectX::XMFLOAT3 inverseDirection = GetInverseDirection(a_Ray);
+				TraversalStack stack;
+				stack.Push(m_Root);
+				while (!stack.IsEmpty())
+				{
+					const Node& node = m_Nodes[stack.Pop()];
+					float distance = 0.0f;
+					if (!IntersectRay(node.IsLeaf() ? node.m_Tight : node.m_Bounds, a_Ray.m_Origin, inverseDirection, a_MaxDistance, distance))
+					{
+						continue;
+					}
+
+					if (node.IsLeaf())
+					{
+						a_Func(node.m_ID, distance);
+						continue;
+					}
+					stack.Push(node.m_Left);
+					stack.Push(node.m_Right);
+				}
+			}
+
+			/// <summary>
+			/// Finds the entity whose bounds are hit first by a ray.
+			/// </summary>
+			/// <param name="a_Ray">The ray.</param>
+			/// <param name="a_MaxDistance">Hits further away than this are ignored.</param>
+			/// <param name="a_Hit">Receives the entity and the distance if something was hit.</param>
+			/// <returns>True if an entity was hit, otherwise false.</returns>
+			bool RaycastClosest(const Ray& a_Ray, float a_MaxDistance, RaycastHit& a_Hit) const;
+		private:
+			static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+			struct Node
+			{
+				Bounds m_Bounds; /// Enlarged bounds for leaves, the bounds of both children for branches.
+				Bounds m_Tight; /// Bounds of the entity, only used by leaves.
+				uint32_t m_Parent = INVALID_NODE; /// Next free node while the node is not in use.
+				uint32_t m_Left = INVALID_NODE; /// INVALID_NODE for leaves.
+				uint32_t m_Right = INVALID_NODE;
+				int32_t m_Height = 0; /// 0 for leaves, -1 for nodes that are not in use.
+				EntityID m_ID;
+				bool m_Pending = false; /// Whether the leaf waits for EndUpdate to be inserted.
+
+				bool IsLeaf() const
+				{
+					return m_Height == 0;
+				}
+			};
+
+			/// <summary>
+			/// Stack of nodes left to visit. The tree is balanced, so the stack almost never grows beyond its fixed part.
+			/// </summary>
+			class TraversalStack
+			{
+			public:
+				void Push(uint32_t a_Node)
+				{
+					if (m_Size < FIXED_SIZE)
+					{
+						m_Fixed[m_Size] = a_Node;
+					}
+					else
+					{
+						m_Overflow.push_back(a_Node);
+					}
+					m_Size++;
+				}
+
+				uint32_t Pop()
+				{
+					m_Size--;
+					if (m_Size < FIXED_SIZE)
+					{
+						return m_Fixed[m_Size];
+					}
+
+					const uint32_t node = m_Overflow.back();
+					m_Overflow.pop_back();
+					return node;
+				}
+
+				bool IsEmpty() const
+				{
+					return m_Size == 0;
+				}
+			private:
+				static constexpr size_t FIXED_SIZE = 64;
+
+				uint32_t m_Fixed[FIXED_SIZE];
+				std::vector<uint32_t> m_Overflow;
+				size_t m_Size = 0;
+			};
+
+			struct BuildEntry
+			{
+				DirectX::XMFLOAT3 m_Center;
+				uint32_t m_Leaf = INVALID_NODE;
+			};
+
+			enum class FrustumResult
+			{
+				Outside,
+				Intersecting,
+				Inside
+			};
+
+			/// <summary>
+			/// Visits every leaf for which the test passes on the leaf and all branches above it.
+			/// </summary>
+			/// <param name="a_Test">Test on the bounds of a node.</param>
+			/// <param name="a_Func">Function taking the entity of a leaf.</param>
+			template <class Test, class Func>
+			void Traverse(Test&& a_Test, Func&& a_Func) const
+			{
+				if (m_Root == INVALID_NODE)
+				{
+					return;
+				}
+
+				TraversalStack stack;
+				stack.Push(m_Root);
+				while (!stack.IsEmpty())
+				{
+					const Node& node = m_Nodes[stack.Pop()];
+					if (node.IsLeaf())
+					{
+						if (a_Test(node.m_Tight))
+						{
+							a_Func(node.m_ID);
+						}
+						continue;
+					}
+
+					if (a_Test(node.m_Bounds))
+					{
+						stack.Push(node.m_Left);
+						stack.Push(node.m_Right);
+					}
+				}
+			}
+
+			static float GetDistanceSq(const Bounds& a_Bounds, const DirectX::XMFLOAT3& a_Point);
+			static FrustumResult Classify(const Frustum& a_Frustum, const Bounds& a_Bounds);
+			static DirectX::XMFLOAT3 GetInverseDirection(const Ray& a_Ray);
+			static bool IntersectRay(const Bounds& a_Bounds, const DirectX::XMFLOAT3& a_Origin, const DirectX::XMFLOAT3& a_InverseDirection, float a_MaxDistance, float& a_Distance);
+
+			uint32_t AllocateNode();
+			void FreeNode(uint32_t a_Node);
+
+			/// <summary>
+			/// Finds the cheapest place for a leaf, attaches it there and refits the branches above it.
+			/// </summary>
+			void InsertLeaf(uint32_t a_Leaf);
+
+			/// <summary>
+			/// Detaches a leaf and refits the branches above it. The leaf itself stays allocated.
+			/// </summary>
+			void RemoveLeaf(uint32_t a_Leaf);
+
+			/// <summary>
+			/// Checks whether a leaf is attached to the tree. New leaves of a batch are not attached until it ends.
+			/// </summary>
+			bool IsInTree(uint32_t a_Leaf) const;
+
+			/// <summary>
+			/// Rotates a branch if one of its children is more than one level higher than the other.
+			/// </summary>
+			/// <returns>The node that took the place of the branch.</returns>
+			uint32_t Balance(uint32_t a_Node);
+
+			/// <summary>
+			/// Builds a subtree over a range of leaves by splitting them along the longest axis of their centers.
+			/// </summary>
+			/// <returns>The root of the subtree.</returns>
+			uint32_t Build(BuildEntry* a_Entries, size_t a_Count);
+
+			std::vector<Node> m_Nodes;
+			std::vector<uint32_t> m_Leaves; /// Entity index to leaf node, INVALID_NODE if the entity is not in the index.
+			uint32_t m_Root = INVALID_NODE;
+			uint32_t m_FreeList = INVALID_NODE; /// First node that is not in use.
+			std::vector<uint32_t> m_Pending; /// Leaves to insert at EndUpdate, may hold leaves that were removed since.
+			bool m_Batching = false;
+			size_t m_LeafCount = 0;
+			float m_Margin = 0.1f;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "gameplay/TypeIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Describes which component types a system reads and writes during its update. The ECS uses this
+		/// to decide which systems can run at the same time.
+		/// </summary>
+		class SystemAccess
+		{
+		public:
+			/// <summary>
+			/// Declares that the system reads a component type.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Reference to this access description.</returns>
+			template <class ComponentType>
+			SystemAccess& Read()
+			{
+				Add(m_Reads, ComponentTypeIndex::Get<ComponentType>());
+				return *this;
+			}
+
+			/// <summary>
+			/// Declares that the system writes a component type.
+			/// </summary>
+			/// <typeparam name="ComponentType">The component type.</typeparam>
+			/// <returns>Reference to this access description.</returns>
+			template <class ComponentType>
+			SystemAccess& Write()
+			{
+				Add(m_Writes, ComponentTypeIndex::Get<ComponentType>());
+				return *this;
+			}
+
+			/// <summary>
+			/// Declares that the system touches state outside of its components, so it never runs next to another system.
+			/// </summary>
+			/// <returns>Reference to this access description.</returns>
+			SystemAccess& Exclusive()
+			{
+				m_Exclusive = true;
+				return *this;
+			}
+
+			/// <summary>
+			/// Checks whether two systems can not run at the same time.
+			/// </summary>
+			/// <param name="a_Other">The access description of the other system.</param>
+			/// <returns>True if either system writes something the other one reads or writes, otherwise false.</returns>
+			bool ConflictsWith(const SystemAccess& a_Other) const
+			{
+				if (m_Exclusive || a_Other.m_Exclusive)
+				{
+					return true;
+				}
+				for (size_t index : m_Writes)
+				{
+					if (Contains(a_Other.m_Writes, index) || Contains(a_Other.m_Reads, index))
+					{
+						return true;
+					}
+				}
+				for (size_t index : a_Other.m_Writes)
+				{
+					if (Contains(m_Reads, index))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+		private:
+			static void Add(std::vector<size_t>& a_Indices, size_t a_Index)
+			{
+				if (!Contains(a_Indices, a_Index))
+				{
+					a_Indices.push_back(a_Index);
+				}
+			}
+
+			static bool Contains(const std::vector<size_t>& a_Indices, size_t a_Index)
+			{
+				return std::find(a_Indices.begin(), a_Indices.end(), a_Index) != a_Indices.end();
+			}
+
+			std::vector<size_t> m_Reads; /// Component types that are only read.
+			std::vector<size_t> m_Writes; /// Component types that are written.
+			bool m_Exclusive = false;
+		};
+	}
+}
\ No newline at end of file
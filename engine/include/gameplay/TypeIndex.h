@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Hands out dense, zero-based indices to types. Every family has its own counter, so the indices
+		/// of one family can be used directly as array slots.
+		/// </summary>
+		/// <typeparam name="Family">Tag type that separates the counters.</typeparam>
+		template <class Family>
+		class TypeIndex
+		{
+		public:
+			/// <summary>
+			/// Retrieves the index of a type. The index is assigned on the first call and stays the same afterwards.
+			/// </summary>
+			/// <typeparam name="T">The type to retrieve the index of.</typeparam>
+			/// <returns>The index of the type within the family.</returns>
+			template <class T>
+			static size_t Get()
+			{
+				static const size_t index = s_NextIndex.fetch_add(1);
+				return index;
+			}
+		private:
+			inline static std::atomic<size_t> s_NextIndex{ 0 };
+		};
+
+		struct SystemTypeFamily;
+		struct ComponentTypeFamily;
+		struct EventTypeFamily;
+
+		using SystemTypeIndex = TypeIndex<SystemTypeFamily>;
+		using ComponentTypeIndex = TypeIndex<ComponentTypeFamily>;
+		using EventTypeIndex = TypeIndex<EventTypeFamily>;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Copy of the component pool of a single system, created by AbstractECSSystem::SaveComponents.
+		/// </summary>
+		class AbstractComponentPoolCopy
+		{
+		public:
+			virtual ~AbstractComponentPoolCopy() = default;
+		};
+
+		/// <summary>
+		/// In-memory copy of the whole world: the entity bookkeeping of the ECS and the components of every system.
+		/// Saving into a snapshot that was used before reuses its allocations.
+		/// </summary>
+		struct WorldSnapshot
+		{
+			bool m_Valid = false; /// Whether the snapshot holds a world.
+			std::vector<EntityID> m_Entities;
+			std::vector<uint32_t> m_Generations;
+			std::vector<uint32_t> m_EntitySlots;
+			EntitySignatures m_Signatures; /// Holds the tags, which are not stored by any system.
+			std::vector<EntityID> m_ReservableIDs;
+			uint32_t m_NextIndex = 0;
+			std::vector<std::unique_ptr<AbstractComponentPoolCopy>> m_Components; /// One copy for every system, in registration order.
+		};
+	}
+}
\ No newline at end of file
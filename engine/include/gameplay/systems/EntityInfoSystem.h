@@ -3,14 +3,78 @@
 #include "gameplay/ECSBaseSystem.h"
 #include "gameplay/systems/components/EntityInfoComponent.h"
 
+#include <unordered_map>
+
 namespace gallus
 {
 	namespace gameplay
 	{
+		/// <summary>
+		/// Stores the entity info components and keeps a hash index of entity names, so that name lookups
+		/// and unique name generation do not have to scan all entities.
+		/// </summary>
 		class EntityInfoSystem : public ECSBaseSystem<EntityInfoComponent>
 		{
 		public:
 			std::string GetPropertyName() const override;
+
+			bool WriteSnapshot(SnapshotWriter& a_Writer, uint32_t& a_Count) const override;
+			bool ReadSnapshot(SnapshotReader& a_Reader, uint32_t a_Count) override;
+
+			size_t WriteDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince) const override;
+			bool ReadDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures) override;
+
+			/// <summary>
+			/// Finds an entity by its name.
+			/// </summary>
+			/// <param name="a_Name">The name to look for.</param>
+			/// <returns>An entity with the name, or an invalid id if no entity has it.</returns>
+			EntityID FindEntity(const std::string& a_Name) const;
+
+			/// <summary>
+			/// Checks whether any entity has a name.
+			/// </summary>
+			/// <param name="a_Name">The name to look for.</param>
+			/// <returns>True if the name is taken, otherwise false.</returns>
+			bool IsNameTaken(const std::string& a_Name) const;
+
+			/// <summary>
+			/// Generates a name that no entity has yet by appending " (n)" to the name if it is taken.
+			/// </summary>
+			/// <param name="a_Name">The preferred name.</param>
+			/// <returns>The unique name.</returns>
+			std::string GetUniqueName(const std::string& a_Name);
+
+			/// <summary>
+			/// Moves an entity from one name to another in the index. Called by EntityInfoComponent::SetName.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_OldName">The previous name.</param>
+			/// <param name="a_NewName">The new name.</param>
+			void OnNameChanged(const EntityID& a_ID, const std::string& a_OldName, const std::string& a_NewName);
+
+			void SaveComponents(std::unique_ptr<AbstractComponentPoolCopy>& a_Copy) const override;
+			void RestoreComponents(const AbstractComponentPoolCopy* a_Copy) override;
+
+			bool Destroy() override;
+		protected:
+			void OnComponentAdded(const EntityID& a_ID, EntityInfoComponent& a_Component) override;
+			void OnComponentRemoved(const EntityID& a_ID, EntityInfoComponent& a_Component) override;
+		private:
+			class EntityInfoPoolCopy : public ComponentPoolCopy
+			{
+			public:
+				uint64_t m_NameIndexVersion = 0; /// Version of the name index when the copy was made.
+			};
+
+			void AddName(const EntityID& a_ID, const std::string& a_Name);
+			void RemoveName(const EntityID& a_ID, const std::string& a_Name);
+
+			std::unordered_map<std::string, std::vector<EntityID>> m_Names; /// Entities by name.
+			std::vector<uint32_t> m_NameSlots; /// Entity index to its position in the list of its name.
+			std::unordered_map<std::string, uint32_t> m_NextSuffix; /// First suffix that may be free, by base name.
+			uint64_t m_NameIndexVersion = 0; /// Changes whenever the name index changes, so restoring a copy can skip rebuilding it.
+			uint64_t m_NextNameIndexVersion = 1;
 		};
 	}
 }
\ No newline at end of file
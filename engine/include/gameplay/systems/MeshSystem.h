@@ -10,9 +10,38 @@ namespace gallus
 		class MeshSystem : public ECSBaseSystem<MeshComponent>
 		{
 		public:
-			std::map<EntityID, MeshComponent>& GetComponents();
-
 			std::string GetPropertyName() const override;
+
+			/// <summary>
+			/// Replaces the mesh of an entity and records the change. This is the only way to replace a mesh, so the
+			/// spatial index never keeps the bounds of an old one. Adds the component if the entity has none.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_Mesh">The new mesh.</param>
+			void SetMesh(const EntityID& a_ID, graphics::dx12::Mesh& a_Mesh);
+
+			/// <summary>
+			/// Retrieves the entities whose mesh component was added, replaced or removed since the list was last cleared.
+			/// An entity can be in the list more than once.
+			/// </summary>
+			/// <returns>The entities.</returns>
+			const std::vector<EntityID>& GetChangedMeshes() const;
+
+			/// <summary>
+			/// Checks whether all components were replaced since the list was last cleared, in which case the list is
+			/// incomplete and every mesh counts as changed.
+			/// </summary>
+			/// <returns>True if all meshes changed, otherwise false.</returns>
+			bool HaveAllMeshesChanged() const;
+
+			void ClearChangedMeshes();
+		protected:
+			void OnComponentAdded(const EntityID& a_ID, MeshComponent& a_Component) override;
+			void OnComponentRemoved(const EntityID& a_ID, MeshComponent& a_Component) override;
+			void OnComponentsRestored() override;
+		private:
+			std::vector<EntityID> m_ChangedMeshes;
+			bool m_AllMeshesChanged = false;
 		};
 	}
 }
\ No newline at end of file
@@ -3,14 +3,107 @@
 #include "gameplay/ECSBaseSystem.h"
 #include "gameplay/systems/components/TransformComponent.h"
 
+#include <DirectXMath.h>
+
 namespace gallus
 {
 	namespace gameplay
 	{
+		/// <summary>
+		/// Stores transforms and keeps a cache of their world matrices. The cache is sorted by hierarchy depth, so parents
+		/// always come before their children, and is brought up to date once per frame for the transforms that changed
+		/// and everything below them.
+		/// </summary>
 		class TransformSystem : public ECSBaseSystem<TransformComponent>
 		{
 		public:
 			std::string GetPropertyName() const override;
+
+			bool WriteSnapshot(SnapshotWriter& a_Writer, uint32_t& a_Count) const override;
+			bool ReadSnapshot(SnapshotReader& a_Reader, uint32_t a_Count) override;
+
+			/// <summary>
+			/// Writes the changed axes of the position, rotation and scale as quantized differences, and the parent if it changed.
+			/// </summary>
+			size_t WriteDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince) const override;
+			bool ReadDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures) override;
+
+			void SetChangeTickSource(std::atomic<uint32_t>* a_ChangeTick) override;
+			void ApplyPendingDeletes() override;
+			void UpdateComponents(float a_DeltaTime) override;
+
+			/// <summary>
+			/// Fills in the stats of the pool, with the world matrix cache counted as allocated memory.
+			/// </summary>
+			/// <param name="a_Stats">The stats to fill.</param>
+			void GetStats(SystemStats& a_Stats) const override;
+
+			/// <summary>
+			/// Retrieves the cached world matrix of an entity, as of the last update.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The world matrix, or identity if the entity has no transform in the cache.</returns>
+			DirectX::XMMATRIX GetWorldMatrix(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Sets the local transform of an entity so that it ends up at the given world matrix.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_WorldMatrix">The world matrix.</param>
+			void SetWorldMatrix(const EntityID& a_ID, const DirectX::XMMATRIX& a_WorldMatrix);
+
+			/// <summary>
+			/// Calls a function for every world matrix that was recomputed during the last update.
+			/// </summary>
+			/// <param name="a_Func">Function taking the entity and its world matrix.</param>
+			template <class Func>
+			void ForEachUpdatedWorldMatrix(Func&& a_Func) const
+			{
+				for (uint32_t entry : m_Updated)
+				{
+					a_Func(m_Order[entry], m_WorldMatrices[entry]);
+				}
+			}
+
+			/// <summary>
+			/// Retrieves a number that changes whenever the cache is rebuilt, which happens when transforms are added,
+			/// removed or reparented. Every world matrix is recomputed after a rebuild.
+			/// </summary>
+			/// <returns>The layout version.</returns>
+			uint32_t GetLayoutVersion() const;
+		protected:
+			void OnComponentsRestored() override;
+		private:
+			static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+			/// <summary>
+			/// Sorts all transforms by depth and rebuilds the cache layout.
+			/// </summary>
+			void RebuildHierarchy();
+
+			/// <summary>
+			/// Recomputes the world matrices of changed transforms and their descendants.
+			/// </summary>
+			void UpdateWorldMatrices();
+
+			/// <summary>
+			/// Retrieves the cached world matrix of the parent of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The world matrix of the parent, or identity if the entity is a root.</returns>
+			DirectX::XMMATRIX GetParentWorldMatrix(const EntityID& a_ID) const;
+
+			std::vector<EntityID> m_Order; /// Entities in the cache, sorted by depth.
+			std::vector<uint32_t> m_Parents; /// Cache index of the parent of every entry, INVALID_INDEX for roots.
+			std::vector<EntityID> m_ParentIDs; /// Parent the cache layout was built with, used to detect reparenting.
+			std::vector<DirectX::XMFLOAT4X4> m_WorldMatrices; /// World matrix of every entry.
+			std::vector<uint8_t> m_Dirty; /// Whether an entry was recomputed during the current update.
+			std::vector<uint32_t> m_Updated; /// Cache indices of the entries recomputed during the last update.
+			std::vector<uint32_t> m_CacheIndices; /// Entity index to cache index, INVALID_INDEX if not cached.
+			std::atomic<uint32_t>* m_ChangeTick = nullptr; /// Change tick counter of the owning ECS, the pool is stamped with it.
+			uint32_t m_ChangedSince = 0; /// First change tick that has not been processed yet.
+			uint32_t m_LayoutVersion = 0;
+			bool m_HierarchyDirty = true;
 		};
 	}
 }
\ No newline at end of file
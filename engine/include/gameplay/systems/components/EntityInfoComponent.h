@@ -1,12 +1,13 @@
 #pragma once
 
 #include "gameplay/systems/components/Component.h"
+#include "gameplay/EntityID.h"
 
 namespace gallus
 {
 	namespace gameplay
 	{
-		struct EntityID;
+		class EntityInfoSystem;
 
 		class EntityInfoComponent : public Component
 		{
@@ -15,8 +16,19 @@ namespace gallus
 			{
 				return m_Name;
 			}
+			/// <summary>
+			/// Sets the name and updates the name index of the owning system.
+			/// </summary>
+			/// <param name="a_Name">The new name.</param>
 			void SetName(const std::string& a_Name);
 
+			/// <summary>
+			/// Sets the entity and system the component belongs to. Called by the system when the component is added.
+			/// </summary>
+			/// <param name="a_ID">The owning entity.</param>
+			/// <param name="a_System">The owning system.</param>
+			void SetOwner(const EntityID& a_ID, EntityInfoSystem* a_System);
+
 			bool IsActive() const
 			{
 				return m_IsActive;
@@ -28,6 +40,8 @@ namespace gallus
 		private:
 			bool m_IsActive = true;
 			std::string m_Name;
+			EntityID m_ID;
+			EntityInfoSystem* m_System = nullptr;
 		};
 	}
 }
\ No newline at end of file
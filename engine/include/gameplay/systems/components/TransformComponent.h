@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gameplay/systems/components/Component.h"
+#include "gameplay/EntityID.h"
 
 #include "graphics/dx12/Transform.h"
 
@@ -12,11 +13,20 @@ namespace gallus
 		{
 		public:
 			graphics::dx12::Transform& Transform();
+			const graphics::dx12::Transform& Transform() const;
+
+			/// <summary>
+			/// Sets the entity this transform is relative to. An invalid id, or an entity without a transform, makes it a root.
+			/// </summary>
+			/// <param name="a_Parent">The parent entity.</param>
+			void SetParent(const EntityID& a_Parent);
+			const EntityID& GetParent() const;
 
 			void Serialize(rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) const override;
 			void Deserialize(const rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) override;
 		private:
-			graphics::dx12::Transform m_Transform;
+			graphics::dx12::Transform m_Transform; /// Transform relative to the parent.
+			EntityID m_Parent;
 		};
 	}
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <mutex>
 
 #include "graphics/dx12/HeapAllocation.h"
+#include "graphics/dx12/RenderList.h"
 #ifdef _EDITOR 
 #include "editor/imgui/ImGuiWindow.h"
 #endif // _EDITOR
@@ -307,6 +308,15 @@ namespace gallus
 
 				Camera* GetCamera() const;
 
+				/// <summary>
+				/// Retrieves the render lists. The ECS writes and publishes a list every frame, the render thread draws the newest one.
+				/// </summary>
+				/// <returns>Reference to the render list buffer.</returns>
+				RenderListBuffer& GetRenderLists()
+				{
+					return m_RenderLists;
+				};
+
 				SimpleEvent<DX12System&> m_OnInitialize;
 				SimpleEvent<std::shared_ptr<graphics::dx12::CommandList>> m_OnRender;
 				SimpleEvent<const glm::ivec2&, const glm::ivec2&> m_OnResize;
@@ -347,6 +357,8 @@ namespace gallus
 				glm::ivec2 m_Size;
 
 				FPSCounter m_FpsCounter;
+
+				RenderListBuffer m_RenderLists;
 #ifdef _EDITOR
 				editor::imgui::ImGuiWindow m_ImGuiWindow;
 #ifdef _RENDER_TEX
@@ -51,15 +51,26 @@ namespace gallus
 			{
 			public:
 				Mesh();
-				void Render(std::shared_ptr<CommandList> a_CommandList, const Transform& a_Transform, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection);
+				void Render(std::shared_ptr<CommandList> a_CommandList, const DirectX::XMMATRIX& a_WorldMatrix, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection);
 				bool IsValid() const override;
 
 				bool LoadByName(const std::wstring& a_Name, const std::shared_ptr<CommandList> a_CommandList);
 				bool LoadByPath(const fs::path& a_Path, const std::shared_ptr<CommandList> a_CommandList);
+
+				/// <summary>
+				/// Retrieves the box around all vertices of the mesh, in model space.
+				/// </summary>
+				/// <param name="a_Min">Receives the lowest corner.</param>
+				/// <param name="a_Max">Receives the highest corner.</param>
+				/// <returns>True if the mesh has vertices, otherwise false.</returns>
+				bool GetBounds(DirectX::XMFLOAT3& a_Min, DirectX::XMFLOAT3& a_Max) const;
 			private:
 
 				D3D12_SHADER_RESOURCE_VIEW_DESC m_ShaderResourceView;
 				std::vector<MeshPartData*> m_MeshData;
+				DirectX::XMFLOAT3 m_BoundsMin = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+				DirectX::XMFLOAT3 m_BoundsMax = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+				bool m_HasBounds = false;
 			};
 		}
 	}
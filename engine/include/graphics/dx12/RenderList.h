@@ -0,0 +1,106 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			class CommandList;
+			class Mesh;
+			class Shader;
+			class Texture;
+			class Material;
+
+			/// <summary>
+			/// Everything the renderer needs to draw one mesh, copied out of the ECS.
+			/// </summary>
+			struct RenderItem
+			{
+				DirectX::XMFLOAT4X4 m_WorldMatrix;
+				Mesh* m_Mesh = nullptr;
+				Shader* m_Shader = nullptr;
+				Texture* m_Texture = nullptr;
+				Material* m_Material = nullptr;
+				gameplay::EntityID m_ID;
+
+				/// <summary>
+				/// Binds the texture, material and shader and draws the mesh.
+				/// </summary>
+				/// <param name="a_CommandList">The command list to record into.</param>
+				/// <param name="a_CameraView">The view matrix of the camera.</param>
+				/// <param name="a_CameraProjection">The projection matrix of the camera.</param>
+				void Render(std::shared_ptr<CommandList> a_CommandList, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection) const;
+			};
+
+			/// <summary>
+			/// Flat list of everything that is drawn in a frame.
+			/// </summary>
+			struct RenderList
+			{
+				std::vector<RenderItem> m_Items;
+				uint64_t m_Frame = 0; /// Number of the simulation frame the list was extracted in, 0 if nothing was extracted yet.
+			};
+
+			/// <summary>
+			/// Triple buffer of render lists between the thread that extracts them from the ECS and the render thread.
+			/// The writer always has a list of its own to fill, the reader always has a complete list to draw and picks up
+			/// the newest published list when it starts a frame. Neither side ever waits for the other. The lists keep
+			/// their allocations while they rotate.
+			/// Only one thread may write and only one thread may read.
+			/// </summary>
+			class RenderListBuffer
+			{
+			public:
+				/// <summary>
+				/// Retrieves the list the writer fills. It is only seen by the reader after Publish.
+				/// </summary>
+				/// <returns>Reference to the list.</returns>
+				RenderList& GetWriteList()
+				{
+					return m_Lists[m_WriteIndex];
+				}
+
+				/// <summary>
+				/// Hands the written list to the reader. A list that was published earlier and not picked up yet is taken back for writing.
+				/// </summary>
+				void Publish()
+				{
+					const uint32_t previous = m_Ready.exchange(m_WriteIndex | FRESH, std::memory_order_acq_rel);
+					m_WriteIndex = previous & INDEX_MASK;
+				}
+
+				/// <summary>
+				/// Retrieves the newest published list, or the list of the previous call if nothing was published since.
+				/// </summary>
+				/// <returns>Reference to the list, valid until the next call.</returns>
+				const RenderList& Acquire()
+				{
+					if (m_Ready.load(std::memory_order_relaxed) & FRESH)
+					{
+						const uint32_t previous = m_Ready.exchange(m_ReadIndex, std::memory_order_acq_rel);
+						m_ReadIndex = previous & INDEX_MASK;
+					}
+					return m_Lists[m_ReadIndex];
+				}
+			private:
+				static constexpr uint32_t FRESH = 4; /// Set while the ready list has not been picked up by the reader.
+				static constexpr uint32_t INDEX_MASK = 3;
+
+				RenderList m_Lists[3];
+				uint32_t m_WriteIndex = 0; /// Only touched by the writer.
+				uint32_t m_ReadIndex = 1; /// Only touched by the reader.
+				std::atomic<uint32_t> m_Ready{ 2 }; /// The list in between, with FRESH if it was published after the last pick up.
+			};
+		}
+	}
+}
\ No newline at end of file
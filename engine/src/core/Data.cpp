@@ -36,6 +36,10 @@ namespace gallus
 
 		Data::Data(const Data& a_Rhs)
 		{
+			if (!a_Rhs.m_Data)
+			{
+				return;
+			}
 			m_Size = a_Rhs.m_Size;
 			m_Data = malloc(m_Size);
 			if (m_Data)
@@ -44,6 +48,12 @@ namespace gallus
 			}
 		}
 
+		Data::Data(Data&& a_Rhs) noexcept : m_Data(a_Rhs.m_Data), m_Size(a_Rhs.m_Size)
+		{
+			a_Rhs.m_Data = nullptr;
+			a_Rhs.m_Size = 0;
+		}
+
 		Data::~Data()
 		{
 			if (m_Data)
@@ -59,6 +69,12 @@ namespace gallus
 				if (m_Data)
 				{
 					free(m_Data);
+					m_Data = nullptr;
+				}
+				m_Size = 0;
+				if (!a_Other.m_Data)
+				{
+					return *this;
 				}
 				m_Size = a_Other.m_Size;
 				m_Data = reinterpret_cast<unsigned char*>(malloc(m_Size));
@@ -70,11 +86,28 @@ namespace gallus
 			return *this;
 		}
 
+		Data& Data::operator=(Data&& a_Other) noexcept
+		{
+			if (&a_Other != this)
+			{
+				if (m_Data)
+				{
+					free(m_Data);
+				}
+				m_Data = a_Other.m_Data;
+				m_Size = a_Other.m_Size;
+				a_Other.m_Data = nullptr;
+				a_Other.m_Size = 0;
+			}
+			return *this;
+		}
+
 		void Data::Free()
 		{
 			if (m_Data)
 			{
 				free(m_Data);
+				m_Data = nullptr;
 				m_Size = 0;
 			}
 		}
@@ -1,6 +1,7 @@
 #include "core/DataStream.h"
 
 #include <vcruntime_string.h>
+#include <utility>
 
 #include "core/MemoryInfo.h"
 
@@ -27,6 +28,14 @@ namespace gallus
 			m_Pos = 0;
 		}
 
+		DataStream::DataStream(DataStream&& a_Rhs) noexcept : Data(std::move(a_Rhs)), m_Pos(a_Rhs.m_Pos)
+		{
+			a_Rhs.m_Pos = 0;
+		}
+
+		DataStream::DataStream(Data&& a_Rhs) noexcept : Data(std::move(a_Rhs))
+		{ }
+
 		DataStream& DataStream::operator=(const DataStream& a_Other)
 		{
 			if (&a_Other != this)
@@ -37,6 +46,17 @@ namespace gallus
 			return *this;
 		}
 
+		DataStream& DataStream::operator=(DataStream&& a_Other) noexcept
+		{
+			if (&a_Other != this)
+			{
+				Data::operator=(std::move(a_Other));
+				m_Pos = a_Other.m_Pos;
+				a_Other.m_Pos = 0;
+			}
+			return *this;
+		}
+
 		void DataStream::Free()
 		{
 			Data::Free();
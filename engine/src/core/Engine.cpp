@@ -20,6 +20,9 @@ namespace gallus
 
 			LOG(LOGSEVERITY_INFO, CATEGORY_ENGINE, "Initializing engine.");
 
+			// Everything that loads files can queue requests on the file I/O system, so it needs to be running first.
+			m_FileIOSystem.Initialize();
+
 			// Initialize the input system, we do not need to wait until it is ready.
 			m_InputSystem.Initialize(false);
 
@@ -41,6 +44,9 @@ namespace gallus
 			// TODO: We can initialize DX12 without having to wait for it for now. Later when we introduce the editor it might be important to wait.
 			m_DX12System.Initialize(true, m_Window.GetHWnd(), m_Window.GetRealSize(), &m_Window);
 
+			// The ECS schedules its systems on the job system, so it needs to be running first.
+			m_JobSystem.Initialize();
+
 			m_ECS.Initialize();
 
 			System::Initialize();
@@ -60,9 +66,25 @@ namespace gallus
 			TEST(seconds.c_str());
 #endif
 
+			m_FrameScheduler.Initialize();
 			while (m_Ready.load())
 			{
-				m_ECS.Update(0);
+				m_FrameScheduler.BeginFrame();
+				if (m_FrameScheduler.GetFixedTimeStep() > 0.0f)
+				{
+					while (m_FrameScheduler.StepFixed())
+					{
+						m_ECS.Update(m_FrameScheduler.GetFixedTimeStep());
+					}
+				}
+				else
+				{
+					m_ECS.Update(m_FrameScheduler.GetDeltaTime());
+				}
+
+				// Once per frame, however many fixed steps ran.
+				m_ECS.ExtractRenderList(m_DX12System.GetRenderLists());
+				m_FrameScheduler.WaitForNextFrame();
 			}
 
 			return true;
@@ -76,10 +98,16 @@ namespace gallus
 
 			m_DX12System.Destroy();
 
+			m_JobSystem.Destroy();
+
+			m_FrameScheduler.Destroy();
+
 #ifdef _EDITOR
 			m_Editor.Destroy();
 #endif // _EDITOR
 
+			m_FileIOSystem.Destroy();
+
 			m_Window.Destroy();
 
 			// Destroy the logger last so we can see possible error messages from other systems.
@@ -108,6 +136,21 @@ namespace gallus
 			return m_ECS;
 		}
 
+		JobSystem& Engine::GetJobSystem()
+		{
+			return m_JobSystem;
+		}
+
+		file::FileIOSystem& Engine::GetFileIOSystem()
+		{
+			return m_FileIOSystem;
+		}
+
+		FrameScheduler& Engine::GetFrameScheduler()
+		{
+			return m_FrameScheduler;
+		}
+
 #ifdef _EDITOR
 		editor::Editor& Engine::GetEditor()
 		{
@@ -0,0 +1,307 @@
+#include "core/FileIOSystem.h"
+
+#include <algorithm>
+
+#include "core/DataStream.h"
+#include "core/FileUtils.h"
+#include "core/logger/Logger.h"
+
+namespace gallus
+{
+	namespace file
+	{
+		bool FileIOSystem::Initialize()
+		{
+			// More threads than this only make requests fight over the disk.
+			return Initialize(2);
+		}
+
+		bool FileIOSystem::Initialize(size_t a_ThreadCount)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				m_Stop = false;
+				m_Running = a_ThreadCount > 0;
+			}
+
+			m_Threads.reserve(a_ThreadCount);
+			for (size_t i = 0; i < a_ThreadCount; i++)
+			{
+				m_Threads.emplace_back(&FileIOSystem::ThreadLoop, this);
+			}
+
+			LOGF(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "File I/O system initialized with %i threads.", static_cast<int>(a_ThreadCount));
+			return System::Initialize();
+		}
+
+		bool FileIOSystem::Destroy()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				m_Stop = true;
+				m_Running = false;
+			}
+			m_QueueCondVar.notify_all();
+
+			for (std::thread& thread : m_Threads)
+			{
+				if (thread.joinable())
+				{
+					thread.join();
+				}
+			}
+			m_Threads.clear();
+
+			// Release anyone still waiting on requests that never started.
+			RequestList cancelled;
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				cancelled.assign(m_Queue.begin(), m_Queue.end());
+				m_Queue.clear();
+			}
+			for (std::shared_ptr<FileIORequest>& request : cancelled)
+			{
+				Finish(*request, FileIOStatus::Cancelled);
+			}
+
+			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "File I/O system destroyed.");
+			return System::Destroy();
+		}
+
+		std::shared_ptr<FileIORequest> FileIOSystem::Read(const fs::path& a_Path, FileIOPriority a_Priority, FileIOCallback a_Callback)
+		{
+			std::shared_ptr<FileIORequest> request = CreateRequest(a_Path, false, a_Priority, std::move(a_Callback));
+			Submit({ request });
+			return request;
+		}
+
+		std::vector<std::shared_ptr<FileIORequest>> FileIOSystem::ReadBatch(const std::vector<fs::path>& a_Paths, FileIOPriority a_Priority, FileIOCallback a_Callback)
+		{
+			RequestList requests;
+			requests.reserve(a_Paths.size());
+			for (const fs::path& path : a_Paths)
+			{
+				requests.push_back(CreateRequest(path, false, a_Priority, a_Callback));
+			}
+
+			// Queued by path so that files of the same folder end up next to each other.
+			RequestList ordered = requests;
+			std::stable_sort(ordered.begin(), ordered.end(), [](const std::shared_ptr<FileIORequest>& a_Lhs, const std::shared_ptr<FileIORequest>& a_Rhs)
+			{
+				return a_Lhs->m_Key < a_Rhs->m_Key;
+			});
+			Submit(ordered);
+
+			return requests;
+		}
+
+		std::shared_ptr<FileIORequest> FileIOSystem::Write(const fs::path& a_Path, core::Data&& a_Data, FileIOPriority a_Priority, FileIOCallback a_Callback)
+		{
+			std::shared_ptr<FileIORequest> request = CreateRequest(a_Path, true, a_Priority, std::move(a_Callback));
+			request->m_Data = std::move(a_Data);
+			Submit({ request });
+			return request;
+		}
+
+		bool FileIOSystem::Cancel(const std::shared_ptr<FileIORequest>& a_Request)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				if (a_Request->GetStatus() != FileIOStatus::Queued || m_Queue.erase(a_Request) == 0)
+				{
+					return false;
+				}
+			}
+
+			Finish(*a_Request, FileIOStatus::Cancelled);
+			return true;
+		}
+
+		size_t FileIOSystem::GetThreadCount() const
+		{
+			return m_Threads.size();
+		}
+
+		std::shared_ptr<FileIORequest> FileIOSystem::CreateRequest(const fs::path& a_Path, bool a_Write, FileIOPriority a_Priority, FileIOCallback a_Callback) const
+		{
+			std::shared_ptr<FileIORequest> request = std::make_shared<FileIORequest>();
+			request->m_Path = a_Path;
+			request->m_Write = a_Write;
+			request->m_Priority = a_Priority;
+			request->m_Callback = std::move(a_Callback);
+
+			std::error_code error;
+			const fs::path absolutePath = fs::absolute(a_Path, error);
+			request->m_Key = (error ? a_Path : absolutePath).lexically_normal().generic_string();
+
+			return request;
+		}
+
+		void FileIOSystem::Submit(const RequestList& a_Requests)
+		{
+			bool queued = false;
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				if (m_Running)
+				{
+					for (const std::shared_ptr<FileIORequest>& request : a_Requests)
+					{
+						request->m_Sequence = m_NextSequence++;
+						m_Queue.insert(request);
+					}
+					queued = true;
+				}
+			}
+
+			if (!queued)
+			{
+				for (const std::shared_ptr<FileIORequest>& request : a_Requests)
+				{
+					RequestList single = { request };
+					request->m_Status.store(FileIOStatus::Busy, std::memory_order_relaxed);
+					Execute(single);
+				}
+				return;
+			}
+
+			if (a_Requests.size() == 1)
+			{
+				m_QueueCondVar.notify_one();
+			}
+			else
+			{
+				m_QueueCondVar.notify_all();
+			}
+		}
+
+		bool FileIOSystem::TakeRequests(RequestList& a_Requests)
+		{
+			auto first = std::find_if(m_Queue.begin(), m_Queue.end(), [this](const std::shared_ptr<FileIORequest>& a_Request)
+			{
+				return m_BusyFiles.find(a_Request->m_Key) == m_BusyFiles.end();
+			});
+			if (first == m_Queue.end())
+			{
+				return false;
+			}
+
+			// Priority only decides which file goes next. Requests for the same file run in the order they were queued, so a
+			// request never jumps an earlier one of the other kind and a read never sees stale or future data.
+			const std::string key = (*first)->m_Key;
+			RequestList sameFile;
+			for (const std::shared_ptr<FileIORequest>& request : m_Queue)
+			{
+				if (request->m_Key == key)
+				{
+					sameFile.push_back(request);
+				}
+			}
+			std::sort(sameFile.begin(), sameFile.end(), [](const std::shared_ptr<FileIORequest>& a_Lhs, const std::shared_ptr<FileIORequest>& a_Rhs)
+			{
+				return a_Lhs->m_Sequence < a_Rhs->m_Sequence;
+			});
+
+			// The oldest request is merged with the ones of the same kind that directly follow it.
+			const bool write = sameFile.front()->m_Write;
+			for (const std::shared_ptr<FileIORequest>& request : sameFile)
+			{
+				if (request->m_Write != write)
+				{
+					break;
+				}
+
+				request->m_Status.store(FileIOStatus::Busy, std::memory_order_relaxed);
+				m_Queue.erase(request);
+				a_Requests.push_back(request);
+			}
+
+			// Only the newest data of merged writes ends up in the file.
+			if (write)
+			{
+				auto newest = std::max_element(a_Requests.begin(), a_Requests.end(), [](const std::shared_ptr<FileIORequest>& a_Lhs, const std::shared_ptr<FileIORequest>& a_Rhs)
+				{
+					return a_Lhs->m_Sequence < a_Rhs->m_Sequence;
+				});
+				std::iter_swap(a_Requests.begin(), newest);
+			}
+
+			m_BusyFiles.insert(a_Requests.front()->m_Key);
+			return true;
+		}
+
+		void FileIOSystem::Execute(RequestList& a_Requests)
+		{
+			FileIORequest& first = *a_Requests.front();
+
+			bool success = false;
+			if (first.m_Write)
+			{
+				success = FileLoader::SaveFile(first.m_Path, first.m_Data);
+			}
+			else
+			{
+				core::DataStream data;
+				success = FileLoader::LoadFile(first.m_Path, data);
+				first.m_Data = std::move(data);
+
+				// Requests that were merged get a copy, which is still a lot cheaper than reading the file again.
+				for (size_t i = 1; i < a_Requests.size(); i++)
+				{
+					a_Requests[i]->m_Data = first.m_Data;
+				}
+			}
+
+			for (std::shared_ptr<FileIORequest>& request : a_Requests)
+			{
+				Finish(*request, success ? FileIOStatus::Done : FileIOStatus::Failed);
+			}
+		}
+
+		void FileIOSystem::Finish(FileIORequest& a_Request, FileIOStatus a_Status)
+		{
+			a_Request.m_Status.store(a_Status, std::memory_order_release);
+			if (a_Request.m_Callback)
+			{
+				a_Request.m_Callback(a_Request);
+				a_Request.m_Callback = nullptr;
+			}
+			a_Request.m_Finished.store(true, std::memory_order_release);
+			a_Request.m_Finished.notify_all();
+		}
+
+		void FileIOSystem::ThreadLoop()
+		{
+			while (true)
+			{
+				RequestList requests;
+				{
+					std::unique_lock<std::mutex> lock(m_QueueMutex);
+					m_QueueCondVar.wait(lock, [this, &requests]()
+					{
+						return m_Stop || TakeRequests(requests);
+					});
+					if (requests.empty())
+					{
+						return;
+					}
+				}
+
+				const std::string key = requests.front()->m_Key;
+				Execute(requests);
+
+				bool queued = false;
+				{
+					std::lock_guard<std::mutex> lock(m_QueueMutex);
+					m_BusyFiles.erase(key);
+					queued = !m_Queue.empty();
+				}
+
+				// Other requests for the file may have been skipped while it was busy.
+				if (queued)
+				{
+					m_QueueCondVar.notify_all();
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -3,6 +3,13 @@
 #include <ShlObj_core.h>
 #include <filesystem>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "core/DataStream.h"
 #include "core/logger/Logger.h"
 
@@ -12,6 +19,46 @@ namespace gallus
 {
 	namespace file
 	{
+		MappedFile::MappedFile(MappedFile&& a_Rhs) noexcept : m_Data(a_Rhs.m_Data), m_Size(a_Rhs.m_Size)
+		{
+			a_Rhs.m_Data = nullptr;
+			a_Rhs.m_Size = 0;
+		}
+
+		MappedFile::~MappedFile()
+		{
+			Unmap();
+		}
+
+		MappedFile& MappedFile::operator=(MappedFile&& a_Other) noexcept
+		{
+			if (&a_Other != this)
+			{
+				Unmap();
+				m_Data = a_Other.m_Data;
+				m_Size = a_Other.m_Size;
+				a_Other.m_Data = nullptr;
+				a_Other.m_Size = 0;
+			}
+			return *this;
+		}
+
+		void MappedFile::Unmap()
+		{
+			if (!m_Data)
+			{
+				return;
+			}
+
+#ifdef _WIN32
+			UnmapViewOfFile(m_Data);
+#else
+			munmap(const_cast<void*>(m_Data), m_Size);
+#endif
+			m_Data = nullptr;
+			m_Size = 0;
+		}
+
 		const fs::path FileLoader::GetAppDataPath()
 		{
 			PWSTR path_tmp;
@@ -39,18 +86,116 @@ namespace gallus
 			}
 
 			fseek(file, 0, SEEK_END);
-			size_t fileSize = ftell(file);
+			const long fileSize = ftell(file);
 			rewind(file);
 
-			a_Data = core::DataStream(fileSize);
-			fread(a_Data.data(), fileSize, 1, file);
+			if (fileSize <= 0)
+			{
+				fclose(file);
+				a_Data = core::DataStream();
+				return fileSize == 0;
+			}
+
+			// Moved into the output so the buffer is only allocated once.
+			a_Data = core::DataStream(static_cast<size_t>(fileSize));
+			const bool success = fread(a_Data.data(), a_Data.size(), 1, file) == 1;
 
 			fclose(file);
 
+			return success;
+		}
+
+		bool FileLoader::MapFile(const fs::path& a_Path, MappedFile& a_File, uint8_t a_Hints)
+		{
+			a_File.Unmap();
+
+#ifdef _WIN32
+			HANDLE file = CreateFileW(a_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, (a_Hints & MAP_HINT_SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER fileSize = {};
+			if (!GetFileSizeEx(file, &fileSize))
+			{
+				CloseHandle(file);
+				return false;
+			}
+
+			// Empty files cannot be mapped.
+			if (fileSize.QuadPart == 0)
+			{
+				CloseHandle(file);
+				return true;
+			}
+
+			// The view keeps the mapping and the file open, so the handles can be closed right away.
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!mapping)
+			{
+				return false;
+			}
+
+			void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			if (!view)
+			{
+				return false;
+			}
+
+			const size_t size = static_cast<size_t>(fileSize.QuadPart);
+			if (a_Hints & MAP_HINT_WILLNEED)
+			{
+				WIN32_MEMORY_RANGE_ENTRY range = { view, size };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+			}
+#else
+			const int file = open(a_Path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (file < 0)
+			{
+				return false;
+			}
+
+			struct stat fileStat = {};
+			if (fstat(file, &fileStat) != 0)
+			{
+				close(file);
+				return false;
+			}
+
+			if (fileStat.st_size == 0)
+			{
+				close(file);
+				return true;
+			}
+
+			// The mapping keeps the file open, so it can be closed right away.
+			const size_t size = static_cast<size_t>(fileStat.st_size);
+			void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+			if (view == MAP_FAILED)
+			{
+				return false;
+			}
+
+			if (a_Hints & MAP_HINT_SEQUENTIAL)
+			{
+				madvise(view, size, MADV_SEQUENTIAL);
+			}
+			if (a_Hints & MAP_HINT_WILLNEED)
+			{
+				madvise(view, size, MADV_WILLNEED);
+			}
+#endif
+
+			a_File.m_Data = view;
+			a_File.m_Size = size;
 			return true;
 		}
 
-		bool FileLoader::SaveFile(const fs::path& a_Path, const core::DataStream& a_Data)
+		bool FileLoader::SaveFile(const fs::path& a_Path, const core::DataView& a_Data)
 		{
 			FILE* file = nullptr;
 			fopen_s(&file, a_Path.generic_string().c_str(), "wb");
@@ -59,11 +204,11 @@ namespace gallus
 				return false;
 			}
 
-			fwrite(a_Data.data(), a_Data.size(), 1, file);
+			const bool success = a_Data.empty() || fwrite(a_Data.data(), a_Data.size(), 1, file) == 1;
 
 			fclose(file);
 
-			return true;
+			return success;
 		}
 
 		bool FileLoader::CreateFolder(const fs::path& a_Path)
@@ -0,0 +1,183 @@
+#include "core/FrameScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif // _WIN32
+
+#include "core/logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		namespace
+		{
+			constexpr std::chrono::microseconds SPIN_TIME(1000); /// Time before a deadline that is spent yielding instead of sleeping.
+		}
+
+		bool FrameScheduler::Initialize()
+		{
+#if defined(_WIN32) && defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+			// High resolution timers sleep with sub-millisecond precision without changing the global timer resolution.
+			m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif // _WIN32 && CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+			if (!m_Timer)
+			{
+				LOG(LOGSEVERITY_WARNING, LOG_CATEGORY_ENGINE, "High resolution timer not available, falling back to regular sleeps.");
+			}
+
+			m_FrameStart = Clock::now();
+			m_NextFrame = m_FrameStart;
+			m_DeltaTime = 0.0;
+			m_Accumulator = 0.0;
+			m_FrameCount = 0;
+
+			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "Frame scheduler initialized.");
+			return System::Initialize();
+		}
+
+		bool FrameScheduler::Destroy()
+		{
+#ifdef _WIN32
+			if (m_Timer)
+			{
+				CloseHandle(m_Timer);
+			}
+#endif // _WIN32
+			m_Timer = nullptr;
+			return System::Destroy();
+		}
+
+		void FrameScheduler::SetTargetFrameRate(double a_FramesPerSecond)
+		{
+			m_TargetFrameRate.store(std::max(a_FramesPerSecond, 0.0));
+		}
+
+		double FrameScheduler::GetTargetFrameRate() const
+		{
+			return m_TargetFrameRate.load();
+		}
+
+		void FrameScheduler::SetFixedTimeStep(double a_Seconds)
+		{
+			m_FixedTimeStep.store(std::max(a_Seconds, 0.0));
+		}
+
+		float FrameScheduler::GetFixedTimeStep() const
+		{
+			return static_cast<float>(m_FixedTimeStep.load());
+		}
+
+		void FrameScheduler::BeginFrame()
+		{
+			const Clock::time_point now = Clock::now();
+			m_DeltaTime = std::min(std::chrono::duration<double>(now - m_FrameStart).count(), MAX_DELTA_TIME);
+			m_FrameStart = now;
+			m_FrameCount++;
+
+			m_FixedSteps = 0;
+			if (m_FixedTimeStep.load() > 0.0)
+			{
+				m_Accumulator += m_DeltaTime;
+			}
+			else
+			{
+				m_Accumulator = 0.0;
+				m_InterpolationAlpha.store(1.0f);
+			}
+		}
+
+		float FrameScheduler::GetDeltaTime() const
+		{
+			return static_cast<float>(m_DeltaTime);
+		}
+
+		bool FrameScheduler::StepFixed()
+		{
+			const double step = m_FixedTimeStep.load();
+			if (step <= 0.0)
+			{
+				return false;
+			}
+
+			if (m_Accumulator >= step && m_FixedSteps < MAX_FIXED_STEPS)
+			{
+				m_Accumulator -= step;
+				m_FixedSteps++;
+				return true;
+			}
+
+			// When the simulation can not keep up, drop the backlog instead of spending ever more steps on it.
+			if (m_FixedSteps == MAX_FIXED_STEPS)
+			{
+				m_Accumulator = std::fmod(m_Accumulator, step);
+			}
+			m_InterpolationAlpha.store(static_cast<float>(m_Accumulator / step));
+			return false;
+		}
+
+		float FrameScheduler::GetInterpolationAlpha() const
+		{
+			return m_InterpolationAlpha.load();
+		}
+
+		void FrameScheduler::WaitForNextFrame()
+		{
+			const double frameRate = m_TargetFrameRate.load();
+			if (frameRate <= 0.0)
+			{
+				std::this_thread::yield();
+				return;
+			}
+
+			// Deadlines advance by a fixed amount so that oversleeping in one frame is made up in the next.
+			const Clock::duration frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+			const Clock::time_point now = Clock::now();
+			m_NextFrame += frameTime;
+			if (m_NextFrame + frameTime < now)
+			{
+				// More than a frame behind, start over instead of running frames back to back to catch up.
+				m_NextFrame = now;
+				return;
+			}
+			SleepUntil(m_NextFrame);
+		}
+
+		uint64_t FrameScheduler::GetFrameCount() const
+		{
+			return m_FrameCount;
+		}
+
+		void FrameScheduler::SleepUntil(Clock::time_point a_Deadline) const
+		{
+			for (Clock::time_point now = Clock::now(); now < a_Deadline; now = Clock::now())
+			{
+				const Clock::duration remaining = a_Deadline - now;
+				if (remaining <= SPIN_TIME)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+#ifdef _WIN32
+				if (m_Timer)
+				{
+					// Negative due times are relative, in 100 nanosecond units.
+					LARGE_INTEGER dueTime;
+					dueTime.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - SPIN_TIME).count() / 100);
+					if (SetWaitableTimerEx(m_Timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+					{
+						WaitForSingleObject(m_Timer, INFINITE);
+						continue;
+					}
+				}
+#endif // _WIN32
+				std::this_thread::sleep_for(remaining - SPIN_TIME);
+			}
+		}
+	}
+}
\ No newline at end of file
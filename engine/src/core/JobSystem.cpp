@@ -0,0 +1,211 @@
+#include "core/JobSystem.h"
+
+#include "core/logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		namespace
+		{
+			thread_local const JobSystem* t_Owner = nullptr; /// Job system the calling thread is a worker of.
+			thread_local size_t t_WorkerIndex = SIZE_MAX; /// Queue index of the calling worker.
+		}
+
+		bool JobSystem::Initialize()
+		{
+			const size_t hardwareThreads = std::thread::hardware_concurrency();
+			return Initialize(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+		}
+
+		bool JobSystem::Initialize(size_t a_WorkerCount)
+		{
+			m_Stop.store(false);
+			m_Queues.reserve(a_WorkerCount);
+			for (size_t i = 0; i < a_WorkerCount; i++)
+			{
+				m_Queues.push_back(std::make_unique<WorkerQueue>());
+			}
+
+			// All queues have to exist before the first worker starts stealing.
+			m_Workers.reserve(a_WorkerCount);
+			for (size_t i = 0; i < a_WorkerCount; i++)
+			{
+				m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+			}
+
+			LOGF(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "Job system initialized with %i workers.", static_cast<int>(a_WorkerCount));
+			return System::Initialize();
+		}
+
+		bool JobSystem::Destroy()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				m_Stop.store(true);
+			}
+			m_SleepCondVar.notify_all();
+
+			for (std::thread& worker : m_Workers)
+			{
+				if (worker.joinable())
+				{
+					worker.join();
+				}
+			}
+			m_Workers.clear();
+
+			// Release anyone still waiting on discarded jobs.
+			for (std::unique_ptr<WorkerQueue>& queue : m_Queues)
+			{
+				for (Job& job : queue->m_Jobs)
+				{
+					job.m_Group->m_Pending.fetch_sub(1, std::memory_order_release);
+				}
+			}
+			m_Queues.clear();
+			m_QueuedJobs.store(0);
+
+			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "Job system destroyed.");
+			return System::Destroy();
+		}
+
+		void JobSystem::Run(JobGroup& a_Group, std::function<void()> a_Job)
+		{
+			a_Group.m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+			Job job = { std::move(a_Job), &a_Group };
+			if (m_Queues.empty())
+			{
+				Execute(job);
+				return;
+			}
+
+			// Workers keep their own jobs close, other threads spread them over all queues.
+			size_t queueIndex = GetCurrentWorker();
+			if (queueIndex == SIZE_MAX)
+			{
+				queueIndex = m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Queues.size();
+			}
+
+			// Counted before it is pushed so the counter can never drop below zero when the job gets taken right away.
+			m_QueuedJobs.fetch_add(1, std::memory_order_release);
+			WorkerQueue& queue = *m_Queues[queueIndex];
+			{
+				std::lock_guard<std::mutex> lock(queue.m_Mutex);
+				queue.m_Jobs.push_back(std::move(job));
+			}
+
+			// Taking the lock makes sure a worker that is about to sleep does not miss the notification.
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+			}
+			m_SleepCondVar.notify_one();
+		}
+
+		void JobSystem::Wait(JobGroup& a_Group)
+		{
+			while (!a_Group.IsDone())
+			{
+				if (!TryRunJob())
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		size_t JobSystem::GetWorkerCount() const
+		{
+			return m_Workers.size();
+		}
+
+		bool JobSystem::TryRunJob()
+		{
+			if (m_Queues.empty())
+			{
+				return false;
+			}
+
+			Job job;
+			const size_t worker = GetCurrentWorker();
+			if (worker != SIZE_MAX)
+			{
+				if (!PopJob(worker, job) && !StealJob(worker, job))
+				{
+					return false;
+				}
+			}
+			else if (!StealJob(m_NextQueue.load(std::memory_order_relaxed) % m_Queues.size(), job))
+			{
+				return false;
+			}
+
+			Execute(job);
+			return true;
+		}
+
+		bool JobSystem::PopJob(size_t a_Queue, Job& a_Job)
+		{
+			WorkerQueue& queue = *m_Queues[a_Queue];
+			std::lock_guard<std::mutex> lock(queue.m_Mutex);
+			if (queue.m_Jobs.empty())
+			{
+				return false;
+			}
+
+			// Newest first, its data is most likely still in cache.
+			a_Job = std::move(queue.m_Jobs.back());
+			queue.m_Jobs.pop_back();
+			m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		bool JobSystem::StealJob(size_t a_Start, Job& a_Job)
+		{
+			for (size_t i = 1; i <= m_Queues.size(); i++)
+			{
+				WorkerQueue& queue = *m_Queues[(a_Start + i) % m_Queues.size()];
+				std::lock_guard<std::mutex> lock(queue.m_Mutex);
+				if (queue.m_Jobs.empty())
+				{
+					continue;
+				}
+
+				// Oldest first, so the owner keeps working on the jobs it queued last.
+				a_Job = std::move(queue.m_Jobs.front());
+				queue.m_Jobs.pop_front();
+				m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+			return false;
+		}
+
+		void JobSystem::Execute(Job& a_Job)
+		{
+			a_Job.m_Func();
+			a_Job.m_Group->m_Pending.fetch_sub(1, std::memory_order_release);
+		}
+
+		size_t JobSystem::GetCurrentWorker() const
+		{
+			return t_Owner == this ? t_WorkerIndex : SIZE_MAX;
+		}
+
+		void JobSystem::WorkerLoop(size_t a_Index)
+		{
+			t_Owner = this;
+			t_WorkerIndex = a_Index;
+
+			while (!m_Stop.load())
+			{
+				if (TryRunJob())
+				{
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_SleepMutex);
+				m_SleepCondVar.wait(lock, [this]() { return m_Stop.load() || m_QueuedJobs.load(std::memory_order_acquire) > 0; });
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vcruntime_string.h>
 #include <corecrt_malloc.h>
+#include <utility>
 
 #include "core/MemoryInfo.h"
 
@@ -14,7 +15,8 @@ namespace gallus
 
 		ReserveDataStream::ReserveDataStream(const ReserveDataStream& rhs) : DataStream(rhs)
 		{
-			m_ReservedSize = rhs.m_ReservedSize;
+			// Only the written part is copied, so that is all that is reserved.
+			m_ReservedSize = m_Size;
 		}
 
 		ReserveDataStream::ReserveDataStream(const DataStream& rhs) : DataStream(rhs)
@@ -22,12 +24,28 @@ namespace gallus
 			m_ReservedSize = rhs.size();
 		}
 
+		ReserveDataStream::ReserveDataStream(ReserveDataStream&& rhs) noexcept : DataStream(std::move(rhs)), m_ReservedSize(rhs.m_ReservedSize)
+		{
+			rhs.m_ReservedSize = 0;
+		}
+
 		ReserveDataStream& ReserveDataStream::operator=(const ReserveDataStream& a_Other)
 		{
 			if (&a_Other != this)
 			{
 				DataStream::operator=(a_Other);
+				m_ReservedSize = m_Size;
+			}
+			return *this;
+		}
+
+		ReserveDataStream& ReserveDataStream::operator=(ReserveDataStream&& a_Other) noexcept
+		{
+			if (&a_Other != this)
+			{
+				DataStream::operator=(std::move(a_Other));
 				m_ReservedSize = a_Other.m_ReservedSize;
+				a_Other.m_ReservedSize = 0;
 			}
 			return *this;
 		}
@@ -40,18 +58,36 @@ namespace gallus
 
 		bool ReserveDataStream::Write(void const* a_Data, size_t a_Size)
 		{
-			size_t size = m_Size;
-			if (m_Pos == m_ReservedSize || m_Pos + a_Size > m_ReservedSize)
+			if (a_Size == 0)
 			{
-				Reallocate(a_Size);
+				return true;
 			}
-			if (m_Pos == size || m_Pos + a_Size > size)
+
+			const size_t end = m_Pos + a_Size;
+			if (end > m_ReservedSize)
 			{
-				m_Size += a_Size;
+				// Doubling keeps the amount of reallocations logarithmic in the size of the stream.
+				size_t reservedSize = m_ReservedSize * 2;
+				if (reservedSize < end)
+				{
+					reservedSize = end;
+				}
+				if (reservedSize < MIN_RESERVED_SIZE)
+				{
+					reservedSize = MIN_RESERVED_SIZE;
+				}
+				if (!Reallocate(reservedSize))
+				{
+					return false;
+				}
 			}
 
 			memcpy(memory::add(m_Data, m_Pos), a_Data, a_Size);
-			Seek(a_Size, SEEK_CUR);
+			if (end > m_Size)
+			{
+				m_Size = end;
+			}
+			m_Pos = end;
 			return true;
 		}
 
@@ -79,18 +115,42 @@ namespace gallus
 			return false;
 		}
 
-		void ReserveDataStream::Reallocate(size_t a_ExtraSize)
+		bool ReserveDataStream::Reserve(size_t a_Capacity)
+		{
+			if (a_Capacity <= m_ReservedSize)
+			{
+				return true;
+			}
+			return Reallocate(a_Capacity);
+		}
+
+		void ReserveDataStream::ShrinkToFit()
 		{
-			size_t newReservedSize = m_Size + (a_ExtraSize * 2000);
-			void* newData = malloc(newReservedSize);
-			memcpy(newData, m_Data, m_Size);
+			if (m_ReservedSize == m_Size)
+			{
+				return;
+			}
+
+			if (m_Size == 0)
+			{
+				Free();
+				return;
+			}
+			Reallocate(m_Size);
+		}
 
-			if (m_Data)
+		bool ReserveDataStream::Reallocate(size_t a_ReservedSize)
+		{
+			// Realloc can often grow the block in place, which saves copying what was written.
+			void* newData = realloc(m_Data, a_ReservedSize);
+			if (!newData)
 			{
-				free(m_Data);
+				return false;
 			}
-			m_ReservedSize = newReservedSize;
+
+			m_ReservedSize = a_ReservedSize;
 			m_Data = newData;
+			return true;
 		}
 
 		size_t ReserveDataStream::Tell() const
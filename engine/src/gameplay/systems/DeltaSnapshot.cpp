@@ -0,0 +1,542 @@
+#include "gameplay/DeltaSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/ReserveDataStream.h"
+#include "core/logger/Logger.h"
+
+#include "gameplay/EntityComponentSystem.h"
+#include "gameplay/ECSBaseSystem.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		void DeltaWriter::WriteBits(uint64_t a_Value, uint32_t a_Count)
+		{
+			while (a_Count > 0)
+			{
+				const uint32_t offset = m_BitCount % 8;
+				if (offset == 0)
+				{
+					m_Data.push_back(0);
+				}
+
+				const uint32_t bits = std::min(a_Count, 8 - offset);
+				m_Data.back() |= static_cast<uint8_t>((a_Value & ((1u << bits) - 1)) << offset);
+				a_Value >>= bits;
+				a_Count -= bits;
+				m_BitCount += bits;
+			}
+		}
+
+		void DeltaWriter::WriteVarint(uint64_t a_Value)
+		{
+			do
+			{
+				const uint64_t group = a_Value & 0x7F;
+				a_Value >>= 7;
+				WriteBits(group | (a_Value != 0 ? 0x80 : 0), 8);
+			} while (a_Value != 0);
+		}
+
+		void DeltaWriter::WriteSignedVarint(int64_t a_Value)
+		{
+			WriteVarint((static_cast<uint64_t>(a_Value) << 1) ^ static_cast<uint64_t>(a_Value >> 63));
+		}
+
+		void DeltaWriter::WriteEntity(const EntityID& a_ID)
+		{
+			// Generation 0 is never handed out, so it doubles as the marker for invalid handles.
+			WriteVarint(a_ID.GetGeneration());
+			if (a_ID.IsValid())
+			{
+				WriteSignedVarint(static_cast<int64_t>(a_ID.GetIndex()) - static_cast<int64_t>(m_LastIndex));
+				m_LastIndex = a_ID.GetIndex();
+			}
+		}
+
+		void DeltaWriter::WriteString(const std::string& a_Value)
+		{
+			WriteVarint(a_Value.size());
+			for (char character : a_Value)
+			{
+				WriteBits(static_cast<uint8_t>(character), 8);
+			}
+		}
+
+		void DeltaWriter::WriteBytes(const void* a_Data, size_t a_Size)
+		{
+			AlignToByte();
+			const uint8_t* data = reinterpret_cast<const uint8_t*>(a_Data);
+			m_Data.insert(m_Data.end(), data, data + a_Size);
+			m_BitCount += a_Size * 8;
+		}
+
+		void DeltaWriter::AlignToByte()
+		{
+			m_BitCount = m_Data.size() * 8;
+		}
+
+		void DeltaWriter::Rewind(const Position& a_Position)
+		{
+			m_BitCount = a_Position.m_BitCount;
+			m_LastIndex = a_Position.m_LastIndex;
+			m_Data.resize((m_BitCount + 7) / 8);
+			if (m_BitCount % 8 != 0)
+			{
+				m_Data.back() &= static_cast<uint8_t>((1u << (m_BitCount % 8)) - 1);
+			}
+		}
+
+		void DeltaWriter::Clear()
+		{
+			m_Data.clear();
+			m_BitCount = 0;
+			m_LastIndex = 0;
+		}
+
+		uint64_t DeltaReader::ReadBits(uint32_t a_Count)
+		{
+			if (m_BitSize - m_BitPosition < a_Count)
+			{
+				m_Failed = true;
+				m_BitPosition = m_BitSize;
+				return 0;
+			}
+
+			uint64_t value = 0;
+			uint32_t shift = 0;
+			while (shift < a_Count)
+			{
+				const uint32_t offset = m_BitPosition % 8;
+				const uint32_t bits = std::min(a_Count - shift, 8 - offset);
+				const uint64_t byte = m_Data[m_BitPosition / 8] >> offset;
+				value |= (byte & ((1u << bits) - 1)) << shift;
+				shift += bits;
+				m_BitPosition += bits;
+			}
+			return value;
+		}
+
+		uint64_t DeltaReader::ReadVarint()
+		{
+			uint64_t value = 0;
+			for (uint32_t shift = 0; shift < 64; shift += 7)
+			{
+				const uint64_t group = ReadBits(8);
+				value |= (group & 0x7F) << shift;
+				if ((group & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+
+			// More groups than a 64 bit value can have.
+			m_Failed = true;
+			return 0;
+		}
+
+		int64_t DeltaReader::ReadSignedVarint()
+		{
+			const uint64_t value = ReadVarint();
+			return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+		}
+
+		EntityID DeltaReader::ReadEntity()
+		{
+			const uint64_t generation = ReadVarint();
+			if (generation == 0)
+			{
+				return EntityID();
+			}
+
+			const int64_t index = static_cast<int64_t>(m_LastIndex) + ReadSignedVarint();
+			if (generation > UINT32_MAX || index < 0 || index > UINT32_MAX)
+			{
+				m_Failed = true;
+				return EntityID();
+			}
+			m_LastIndex = static_cast<uint32_t>(index);
+			return EntityID(m_LastIndex, static_cast<uint32_t>(generation));
+		}
+
+		std::string DeltaReader::ReadString()
+		{
+			const uint64_t size = ReadVarint();
+			if (size > (m_BitSize - m_BitPosition) / 8)
+			{
+				m_Failed = true;
+				return std::string();
+			}
+
+			std::string value(static_cast<size_t>(size), '\0');
+			for (char& character : value)
+			{
+				character = static_cast<char>(ReadBits(8));
+			}
+			return value;
+		}
+
+		const unsigned char* DeltaReader::ReadBytes(size_t a_Size)
+		{
+			AlignToByte();
+			if ((m_BitSize - m_BitPosition) / 8 < a_Size)
+			{
+				m_Failed = true;
+				m_BitPosition = m_BitSize;
+				return nullptr;
+			}
+
+			const unsigned char* data = m_Data + m_BitPosition / 8;
+			m_BitPosition += a_Size * 8;
+			return data;
+		}
+
+		void DeltaReader::AlignToByte()
+		{
+			m_BitPosition = std::min(m_BitSize, (m_BitPosition + 7) / 8 * 8);
+		}
+
+		DeltaRecorder::DeltaRecorder(uint32_t a_KeyframeInterval) : m_KeyframeInterval(std::max(a_KeyframeInterval, 1u))
+		{}
+
+		bool DeltaRecorder::RecordFrame(EntityComponentSystem& a_ECS, core::ReserveDataStream& a_Stream)
+		{
+			const std::vector<AbstractECSSystem*>& systems = a_ECS.GetSystems();
+			if (m_FrameCount == 0)
+			{
+				m_SystemCount = systems.size();
+
+				DeltaHeader header;
+				header.m_SystemCount = static_cast<uint32_t>(m_SystemCount);
+				header.m_KeyframeInterval = m_KeyframeInterval;
+				a_Stream.Write(&header, sizeof(header));
+				for (size_t i = 0; i < m_SystemCount; i++)
+				{
+					char name[DELTA_NAME_SIZE] = {};
+					const std::string propertyName = systems[i]->GetPropertyName();
+					memcpy(name, propertyName.c_str(), std::min(propertyName.size(), DELTA_NAME_SIZE - 1));
+					a_Stream.Write(name, DELTA_NAME_SIZE);
+				}
+			}
+			else if (systems.size() < m_SystemCount)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Cannot record delta frame, systems were removed since the recording started.");
+				return false;
+			}
+
+			// A keyframe is a delta against an empty world, which is what the baselines start out as.
+			const bool keyframe = m_FrameCount == 0 || m_KeyframeRequested || m_FramesSinceKeyframe >= m_KeyframeInterval;
+			if (keyframe)
+			{
+				m_Entities.clear();
+				m_Generations.clear();
+				m_Baselines.clear();
+				m_FramesSinceKeyframe = 0;
+				m_KeyframeRequested = false;
+			}
+			m_Baselines.resize(m_SystemCount);
+
+			const uint32_t tick = a_ECS.AdvanceChangeTick();
+			const uint32_t changedSince = keyframe ? 0 : m_ChangedSince;
+			m_ChangedSince = tick + 1;
+
+			m_Writer.Clear();
+			WriteEntities(a_ECS);
+			for (size_t i = 0; i < m_SystemCount; i++)
+			{
+				// Blocks are byte aligned and sized, so a player without the system can skip them.
+				m_BlockWriter.Clear();
+				const bool changed = systems[i]->WriteDelta(m_BlockWriter, m_Baselines[i], changedSince) > 0;
+				m_Writer.WriteBool(changed);
+				if (changed)
+				{
+					m_Writer.WriteVarint(m_BlockWriter.GetData().size());
+					m_Writer.WriteBytes(m_BlockWriter.GetData().data(), m_BlockWriter.GetData().size());
+				}
+			}
+
+			DeltaFrameHeader frame;
+			frame.m_Size = static_cast<uint32_t>(m_Writer.GetData().size());
+			frame.m_Flags = keyframe ? DELTA_FRAME_KEYFRAME : 0;
+			a_Stream.Write(&frame, sizeof(frame));
+			if (frame.m_Size > 0)
+			{
+				a_Stream.Write(m_Writer.GetData().data(), frame.m_Size);
+			}
+
+			m_LastFrameSize = sizeof(frame) + frame.m_Size;
+			m_FrameCount++;
+			m_FramesSinceKeyframe++;
+			return true;
+		}
+
+		void DeltaRecorder::Reset()
+		{
+			m_FrameCount = 0;
+			m_FramesSinceKeyframe = 0;
+			m_KeyframeRequested = false;
+			m_SystemCount = 0;
+			m_ChangedSince = 0;
+			m_LastFrameSize = 0;
+			m_Entities.clear();
+			m_Generations.clear();
+			m_Baselines.clear();
+		}
+
+		void DeltaRecorder::WriteEntities(EntityComponentSystem& a_ECS)
+		{
+			for (const EntityID& id : m_Entities)
+			{
+				if (!a_ECS.IsEntityValid(id))
+				{
+					m_Writer.WriteBool(true);
+					m_Writer.WriteEntity(id);
+					m_Generations[id.GetIndex()] = 0;
+				}
+			}
+			m_Writer.WriteBool(false);
+
+			const std::vector<EntityID>& entities = a_ECS.GetEntities();
+			for (const EntityID& id : entities)
+			{
+				if (id.GetIndex() >= m_Generations.size())
+				{
+					m_Generations.resize(static_cast<size_t>(id.GetIndex()) + 1, 0);
+				}
+				if (m_Generations[id.GetIndex()] != id.GetGeneration())
+				{
+					m_Writer.WriteBool(true);
+					m_Writer.WriteEntity(id);
+					m_Generations[id.GetIndex()] = id.GetGeneration();
+				}
+			}
+			m_Writer.WriteBool(false);
+
+			m_Entities = entities;
+		}
+
+		bool DeltaPlayer::Open(EntityComponentSystem& a_ECS, const void* a_Data, size_t a_Size)
+		{
+			m_ECS = &a_ECS;
+			m_Data = reinterpret_cast<const unsigned char*>(a_Data);
+			m_Frames.clear();
+			m_SystemIndices.clear();
+			m_World = WorldSnapshot();
+			m_Frame = NO_FRAME;
+
+			DeltaHeader header;
+			if (a_Size < sizeof(header))
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Delta recording is too small.");
+				return false;
+			}
+			memcpy(&header, m_Data, sizeof(header));
+			if (header.m_Magic != DELTA_MAGIC || header.m_Version != DELTA_VERSION)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Delta recording has an unknown format or version.");
+				return false;
+			}
+			if ((a_Size - sizeof(header)) / DELTA_NAME_SIZE < header.m_SystemCount)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Delta recording system names are out of bounds.");
+				return false;
+			}
+
+			const std::vector<AbstractECSSystem*>& systems = a_ECS.GetSystems();
+			size_t offset = sizeof(header);
+			for (uint32_t i = 0; i < header.m_SystemCount; i++, offset += DELTA_NAME_SIZE)
+			{
+				const char* recordedName = reinterpret_cast<const char*>(m_Data + offset);
+				const std::string name(recordedName, strnlen(recordedName, DELTA_NAME_SIZE));
+				size_t index = SIZE_MAX;
+				for (size_t j = 0; j < systems.size() && !name.empty(); j++)
+				{
+					if (systems[j]->GetPropertyName() == name)
+					{
+						index = j;
+						break;
+					}
+				}
+				m_SystemIndices.push_back(index);
+			}
+
+			while (offset < a_Size)
+			{
+				DeltaFrameHeader frame;
+				if (a_Size - offset < sizeof(frame))
+				{
+					LOG(LOGSEVERITY_WARNING, LOG_CATEGORY_ECS, "Delta recording ends in the middle of a frame header, the last frame is skipped.");
+					break;
+				}
+				memcpy(&frame, m_Data + offset, sizeof(frame));
+				offset += sizeof(frame);
+				if (a_Size - offset < frame.m_Size)
+				{
+					LOG(LOGSEVERITY_WARNING, LOG_CATEGORY_ECS, "Delta recording ends in the middle of a frame, the last frame is skipped.");
+					break;
+				}
+
+				Frame& entry = m_Frames.emplace_back();
+				entry.m_Offset = offset;
+				entry.m_Size = frame.m_Size;
+				entry.m_Keyframe = (frame.m_Flags & DELTA_FRAME_KEYFRAME) != 0;
+				offset += frame.m_Size;
+			}
+
+			if (!m_Frames.empty() && !m_Frames.front().m_Keyframe)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Delta recording does not start with a keyframe.");
+				m_Frames.clear();
+				return false;
+			}
+
+			m_World.m_Components.resize(systems.size());
+			return true;
+		}
+
+		bool DeltaPlayer::Seek(uint32_t a_Frame)
+		{
+			if (!m_ECS || a_Frame >= m_Frames.size())
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Cannot seek to delta frame %u, the recording has %u frames.", a_Frame, GetFrameCount());
+				return false;
+			}
+
+			// The first frame is always a keyframe, Open makes sure of that.
+			uint32_t keyframe = a_Frame;
+			while (!m_Frames[keyframe].m_Keyframe)
+			{
+				keyframe--;
+			}
+
+			// Going forward from the current frame is cheaper than starting over, as long as no keyframe lies in between.
+			const uint32_t first = m_Frame != NO_FRAME && m_Frame >= keyframe && m_Frame <= a_Frame ? m_Frame + 1 : keyframe;
+			for (uint32_t frame = first; frame <= a_Frame; frame++)
+			{
+				if (!ApplyFrame(m_Frames[frame]))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed decoding delta frame %u.", frame);
+					m_Frame = NO_FRAME;
+					m_World.m_Valid = false;
+					return false;
+				}
+			}
+			m_Frame = a_Frame;
+
+			// Free indices can be handed out again by the world the frame is restored into.
+			m_World.m_ReservableIDs.clear();
+			for (uint32_t index = 0; index < m_World.m_EntitySlots.size(); index++)
+			{
+				if (m_World.m_EntitySlots[index] == INVALID_SLOT)
+				{
+					m_World.m_ReservableIDs.emplace_back(index, m_World.m_Generations[index]);
+				}
+			}
+			m_World.m_NextIndex = static_cast<uint32_t>(m_World.m_EntitySlots.size());
+			m_World.m_Valid = true;
+			return true;
+		}
+
+		bool DeltaPlayer::ApplyFrame(const Frame& a_Frame)
+		{
+			if (a_Frame.m_Keyframe)
+			{
+				m_World.m_Entities.clear();
+				m_World.m_Generations.clear();
+				m_World.m_EntitySlots.clear();
+				m_World.m_Signatures.Clear();
+				for (std::unique_ptr<AbstractComponentPoolCopy>& components : m_World.m_Components)
+				{
+					components.reset();
+				}
+			}
+
+			DeltaReader reader(m_Data + a_Frame.m_Offset, a_Frame.m_Size);
+			while (reader.ReadBool())
+			{
+				DestroyEntity(reader.ReadEntity());
+			}
+			while (reader.ReadBool())
+			{
+				CreateEntity(reader.ReadEntity());
+			}
+
+			const std::vector<AbstractECSSystem*>& systems = m_ECS->GetSystems();
+			for (size_t system : m_SystemIndices)
+			{
+				if (!reader.ReadBool())
+				{
+					continue;
+				}
+
+				const size_t size = static_cast<size_t>(reader.ReadVarint());
+				const unsigned char* block = reader.ReadBytes(size);
+				if (!block)
+				{
+					return false;
+				}
+
+				if (system == SIZE_MAX)
+				{
+					continue;
+				}
+
+				DeltaReader blockReader(block, size);
+				if (!systems[system]->ReadDelta(blockReader, m_World.m_Components[system], m_World.m_Signatures) || blockReader.HasFailed())
+				{
+					return false;
+				}
+			}
+			return !reader.HasFailed();
+		}
+
+		void DeltaPlayer::DestroyEntity(const EntityID& a_ID)
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (!a_ID.IsValid() || index >= m_World.m_EntitySlots.size() || m_World.m_EntitySlots[index] == INVALID_SLOT || m_World.m_Entities[m_World.m_EntitySlots[index]] != a_ID)
+			{
+				return;
+			}
+
+			const uint32_t slot = m_World.m_EntitySlots[index];
+			const EntityID last = m_World.m_Entities.back();
+			m_World.m_Entities[slot] = last;
+			m_World.m_EntitySlots[last.GetIndex()] = slot;
+			m_World.m_Entities.pop_back();
+			m_World.m_EntitySlots[index] = INVALID_SLOT;
+			m_World.m_Signatures.ClearEntity(a_ID);
+
+			// Like in the ECS, a free index holds the generation its next occupant gets.
+			if (++m_World.m_Generations[index] == 0)
+			{
+				m_World.m_Generations[index] = 1;
+			}
+		}
+
+		void DeltaPlayer::CreateEntity(const EntityID& a_ID)
+		{
+			if (!a_ID.IsValid())
+			{
+				return;
+			}
+
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_World.m_EntitySlots.size())
+			{
+				m_World.m_Generations.resize(static_cast<size_t>(index) + 1, 1);
+				m_World.m_EntitySlots.resize(static_cast<size_t>(index) + 1, INVALID_SLOT);
+			}
+			else if (m_World.m_EntitySlots[index] != INVALID_SLOT)
+			{
+				DestroyEntity(m_World.m_Entities[m_World.m_EntitySlots[index]]);
+			}
+
+			m_World.m_Generations[index] = a_ID.GetGeneration();
+			m_World.m_EntitySlots[index] = static_cast<uint32_t>(m_World.m_Entities.size());
+			m_World.m_Entities.push_back(a_ID);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "gameplay/EntityCommandBuffer.h"
+
+#include "gameplay/EntityComponentSystem.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		EntityID EntityCommandBuffer::CreateEntity(const std::string& a_Name)
+		{
+			const EntityID id = m_ECS.ReserveEntity();
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Creates.push_back({ id, a_Name });
+			return id;
+		}
+
+		void EntityCommandBuffer::DestroyEntity(const EntityID& a_ID)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Commands.push_back({ CommandType::DestroyEntity, a_ID });
+		}
+	}
+}
\ No newline at end of file
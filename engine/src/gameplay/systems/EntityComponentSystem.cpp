@@ -1,19 +1,38 @@
 #include "gameplay/EntityComponentSystem.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "core/logger/Logger.h"
 
 #include "gameplay/ECSBaseSystem.h"
+#include "gameplay/Prefab.h"
 
 #include "gameplay/systems/EntityInfoSystem.h"
 #include "gameplay/systems/TransformSystem.h"
 #include "gameplay/systems/MeshSystem.h"
+#include "graphics/dx12/Mesh.h"
+#include "graphics/dx12/RenderList.h"
 
 namespace gallus
 {
 	namespace gameplay
 	{
+		/// <summary>
+		/// Local bounds of entities without a mesh, so they can still be found and picked.
+		/// </summary>
+		static const Bounds DEFAULT_LOCAL_BOUNDS = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+
+		static const ComponentSignature EMPTY_SIGNATURE;
+
 		bool EntityComponentSystem::Initialize()
 		{
+			// Queues are dispatched in the order they were created, so creations are delivered first and destructions last.
+			m_CreatedEvents = &m_Events.Get<EntityCreatedEvent>();
+			m_Events.Get<EntityComponentsChangedEvent>();
+			m_DestroyedEvents = &m_Events.Get<EntityDestroyedEvent>();
+			m_Events.Get<WorldRestoredEvent>();
+
 			CreateSystem<EntityInfoSystem>();
 			CreateSystem<TransformSystem>();
 			CreateSystem<MeshSystem>();
@@ -28,55 +47,244 @@ namespace gallus
 			{
 				delete system;
 			}
+			m_Systems.clear();
+			m_SystemsByType.clear();
+			m_SystemsByComponentType.clear();
+			m_Stages.clear();
+			m_Events.Clear();
+			m_Signatures.Clear();
+			m_SpatialIndex.Clear();
+			m_SystemPeaks.clear();
+			m_PeakEntityCount = 0;
 			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ECS, "ECS destroyed.");
 			return System::Destroy();
 		}
 
 		void EntityComponentSystem::Update(const float& a_DeltaTime)
 		{
-			std::lock_guard<std::mutex> lock(m_EntityMutex);
+			bool started = false, paused = false;
+
+			// Structural changes only happen in this block, the systems themselves update without holding the entity mutex.
+			{
+				std::lock_guard<std::mutex> lock(m_EntityMutex);
+
+				ApplyCommandBuffers();
+
+				if (m_Clear)
+				{
+					ClearEntities();
+					m_Clear = false;
+				}
+
+				if (m_RestoreEditWorld)
+				{
+					m_RestoreEditWorld = false;
+					RestoreWorld(m_EditWorld);
+				}
+
+				// Sampled before pending deletions are applied, when the pools are at their fullest.
+				RecordPeakStats();
+
+				for (auto& sys : m_Systems)
+				{
+					sys->UpdateComponents(a_DeltaTime);
+				}
+
+				// The world matrices are up to date and removed components are gone now.
+				UpdateSpatialIndex();
+
+				// Components of deleted entities are gone now, so their indices can be handed out again.
+				RefillReservableIDs();
 
-			bool changed = (!m_EntitiesToDelete.empty()) || m_Clear || (!m_EntitiesToAdd.empty());
+				// Saved last, so the copy does not contain components that are about to be removed.
+				if (m_SaveEditWorld)
+				{
+					m_SaveEditWorld = false;
+					SaveWorld(m_EditWorld);
+				}
+
+				if (m_ScheduleDirty)
+				{
+					BuildSchedule();
+				}
 
-			if (!m_EntitiesToDelete.empty())
+				// Delivered last, so listeners see the world as the systems will update it.
+				m_Events.Dispatch();
+
+				// The editor toggles these from the render thread.
+				started = m_Started;
+				paused = m_Paused;
+			}
+
+			if (!started)
 			{
-				for (EntityID entity : m_EntitiesToDelete)
+				return;
+			}
+
+			if (paused)
+			{
+				return;
+			}
+
+			// Every stage is a sync point, the next stage only starts when all systems of the previous one are done.
+			for (const std::vector<AbstractECSSystem*>& stage : m_Stages)
+			{
+				UpdateStage(stage, a_DeltaTime);
+			}
+		}
+
+		void EntityComponentSystem::ApplyCommandBuffers()
+		{
+			std::vector<EntityCommandBuffer::CreateCommand> creates;
+			std::vector<std::vector<EntityCommandBuffer::Command>> commands;
+
+			// Take everything out of the buffers first so threads can keep recording while the commands are applied.
+			{
+				std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+				commands.reserve(m_CommandBuffers.size());
+				for (std::unique_ptr<EntityCommandBuffer>& buffer : m_CommandBuffers)
 				{
-					DeleteEntity(entity);
+					std::lock_guard<std::mutex> bufferLock(buffer->m_Mutex);
+					std::move(buffer->m_Creates.begin(), buffer->m_Creates.end(), std::back_inserter(creates));
+					buffer->m_Creates.clear();
+					if (!buffer->m_Commands.empty())
+					{
+						commands.push_back(std::move(buffer->m_Commands));
+						buffer->m_Commands.clear();
+					}
 				}
-				m_EntitiesToDelete.clear();
 			}
 
-			if (m_Clear)
+			// Creates go first so commands of any buffer can use the entities. Nothing can refer to an entity before
+			// its create was recorded, so this does not change the outcome of a buffer.
+			m_Entities.reserve(m_Entities.size() + creates.size());
+			for (EntityCommandBuffer::CreateCommand& command : creates)
 			{
-				ClearEntities();
-				m_Clear = false;
+				ActivateEntity(command.m_ID, command.m_Name);
 			}
 
-			if (changed)
+			// The rest is applied in the order it was recorded, so a remove followed by an add of the same component
+			// ends with a new component and a destroy followed by an add does nothing. Removes are still deferred like
+			// DeleteComponent, a system only removes its marked components early when an add for it comes after them.
+			std::vector<bool> pendingDeletes(m_SystemsByComponentType.size(), false);
+			for (std::vector<EntityCommandBuffer::Command>& bufferCommands : commands)
 			{
-				m_OnEntitiesUpdated();
+				for (EntityCommandBuffer::Command& command : bufferCommands)
+				{
+					switch (command.m_Type)
+					{
+						case EntityCommandBuffer::CommandType::AddComponent:
+						{
+							if (command.m_TypeIndex >= m_SystemsByComponentType.size() || !m_SystemsByComponentType[command.m_TypeIndex] || !IsEntityValid(command.m_ID))
+							{
+								break;
+							}
+
+							if (pendingDeletes[command.m_TypeIndex])
+							{
+								m_SystemsByComponentType[command.m_TypeIndex]->ApplyPendingDeletes();
+								pendingDeletes[command.m_TypeIndex] = false;
+							}
+
+							Component* component = m_SystemsByComponentType[command.m_TypeIndex]->GetBaseComponent(command.m_ID);
+							if (command.m_Init)
+							{
+								command.m_Init(*component);
+							}
+							break;
+						}
+						case EntityCommandBuffer::CommandType::RemoveComponent:
+						{
+							if (command.m_TypeIndex < m_SystemsByComponentType.size() && m_SystemsByComponentType[command.m_TypeIndex])
+							{
+								m_SystemsByComponentType[command.m_TypeIndex]->DeleteComponent(command.m_ID);
+								pendingDeletes[command.m_TypeIndex] = true;
+							}
+							break;
+						}
+						case EntityCommandBuffer::CommandType::AddTag:
+						case EntityCommandBuffer::CommandType::RemoveTag:
+						{
+							SetTag(command.m_ID, command.m_TypeIndex, command.m_Type == EntityCommandBuffer::CommandType::AddTag);
+							break;
+						}
+						case EntityCommandBuffer::CommandType::DestroyEntity:
+						{
+							DeleteEntity(command.m_ID);
+							break;
+						}
+					}
+				}
 			}
+		}
 
-			for (auto& sys : m_Systems)
+		void EntityComponentSystem::RefillReservableIDs()
+		{
+			std::unique_lock<std::shared_mutex> lock(m_ReserveMutex);
+
+			const size_t reserved = std::min(m_ReservedCount.load(), m_ReservableIDs.size());
+			m_ReservableIDs.erase(m_ReservableIDs.begin(), m_ReservableIDs.begin() + reserved);
+			m_ReservedCount.store(0);
+
+			for (uint32_t index : m_PendingFreeIndices)
 			{
-				sys->UpdateComponents(a_DeltaTime);
+				m_ReservableIDs.emplace_back(index, m_Generations[index]);
 			}
+			m_PendingFreeIndices.clear();
+		}
 
-			if (!m_Started)
+		void EntityComponentSystem::BuildSchedule()
+		{
+			std::vector<SystemAccess> access(m_Systems.size());
+			std::vector<size_t> stageOfSystem(m_Systems.size(), 0);
+			m_Stages.clear();
+
+			for (size_t i = 0; i < m_Systems.size(); i++)
 			{
-				return;
+				m_Systems[i]->DeclareAccess(access[i]);
+
+				size_t stage = 0;
+				for (size_t j = 0; j < i; j++)
+				{
+					if (access[i].ConflictsWith(access[j]))
+					{
+						stage = std::max(stage, stageOfSystem[j] + 1);
+					}
+				}
+				stageOfSystem[i] = stage;
+
+				if (stage >= m_Stages.size())
+				{
+					m_Stages.resize(stage + 1);
+				}
+				m_Stages[stage].push_back(m_Systems[i]);
 			}
 
-			if (m_Paused)
+			m_ScheduleDirty = false;
+			LOGF(LOGSEVERITY_INFO, LOG_CATEGORY_ECS, "Scheduled %i systems in %i stages.", static_cast<int>(m_Systems.size()), static_cast<int>(m_Stages.size()));
+		}
+
+		void EntityComponentSystem::UpdateStage(const std::vector<AbstractECSSystem*>& a_Stage, float a_DeltaTime)
+		{
+			if (a_Stage.size() == 1)
 			{
+				a_Stage[0]->Update(a_DeltaTime);
 				return;
 			}
 
-			for (auto& sys : m_Systems)
+			// The calling thread takes the first system itself instead of idling.
+			core::JobSystem& jobSystem = core::ENGINE.GetJobSystem();
+			core::JobGroup group;
+			for (size_t i = 1; i < a_Stage.size(); i++)
 			{
-				sys->Update(a_DeltaTime);
+				AbstractECSSystem* system = a_Stage[i];
+				jobSystem.Run(group, [system, a_DeltaTime]()
+				{
+					system->Update(a_DeltaTime);
+				});
 			}
+			a_Stage[0]->Update(a_DeltaTime);
+			jobSystem.Wait(group);
 		}
 
 		bool EntityComponentSystem::IsPaused() const
@@ -96,42 +304,316 @@ namespace gallus
 
 		void EntityComponentSystem::SetStarted(bool a_Started)
 		{
+#ifdef _EDITOR
+			if (a_Started && !m_Started)
+			{
+				m_SaveEditWorld = true;
+				m_RestoreEditWorld = false;
+			}
+			else if (!a_Started && m_Started)
+			{
+				m_RestoreEditWorld = !m_SaveEditWorld;
+				m_SaveEditWorld = false;
+			}
+#endif // _EDITOR
 			m_Started = a_Started;
 		}
 
-		EntityID EntityComponentSystem::CreateEntity(const std::string& a_Name)
+		void EntityComponentSystem::SaveWorld(WorldSnapshot& a_Snapshot)
+		{
+			{
+				std::shared_lock<std::shared_mutex> lock(m_ReserveMutex);
+				a_Snapshot.m_ReservableIDs.assign(m_ReservableIDs.begin() + std::min(m_ReservedCount.load(), m_ReservableIDs.size()), m_ReservableIDs.end());
+				a_Snapshot.m_NextIndex = m_NextIndex.load();
+			}
+			a_Snapshot.m_Entities = m_Entities;
+			a_Snapshot.m_Generations = m_Generations;
+			a_Snapshot.m_EntitySlots = m_EntitySlots;
+			a_Snapshot.m_Signatures = m_Signatures;
+
+			// Indices that are freed but not reservable yet become reservable in the copy.
+			for (uint32_t index : m_PendingFreeIndices)
+			{
+				a_Snapshot.m_ReservableIDs.emplace_back(index, m_Generations[index]);
+			}
+
+			a_Snapshot.m_Components.resize(m_Systems.size());
+			for (size_t i = 0; i < m_Systems.size(); i++)
+			{
+				m_Systems[i]->SaveComponents(a_Snapshot.m_Components[i]);
+			}
+			a_Snapshot.m_Valid = true;
+		}
+
+		bool EntityComponentSystem::RestoreWorld(const WorldSnapshot& a_Snapshot)
 		{
-			EntityID id(++m_NextID);
-			m_Entities.push_back(id);
+			if (!a_Snapshot.m_Valid || a_Snapshot.m_Components.size() > m_Systems.size())
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Cannot restore world, the snapshot is empty or has more systems than the ECS.");
+				return false;
+			}
 
-			GetSystem<EntityInfoSystem>().CreateComponent(id).SetName(a_Name);
+			// Commands recorded during play refer to the world that is thrown away.
+			{
+				std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+				for (std::unique_ptr<EntityCommandBuffer>& buffer : m_CommandBuffers)
+				{
+					std::lock_guard<std::mutex> bufferLock(buffer->m_Mutex);
+					buffer->m_Creates.clear();
+					buffer->m_Commands.clear();
+				}
+			}
 
-			return m_Entities[m_Entities.size() - 1];
+			{
+				std::unique_lock<std::shared_mutex> lock(m_ReserveMutex);
+				m_ReservableIDs = a_Snapshot.m_ReservableIDs;
+				m_ReservedCount.store(0);
+				m_NextIndex.store(a_Snapshot.m_NextIndex);
+			}
+			m_Entities = a_Snapshot.m_Entities;
+			m_Generations = a_Snapshot.m_Generations;
+			m_EntitySlots = a_Snapshot.m_EntitySlots;
+			m_Signatures = a_Snapshot.m_Signatures;
+			m_PendingFreeIndices.clear();
+
+			// Systems created after the snapshot was made had no components in that world.
+			for (size_t i = 0; i < m_Systems.size(); i++)
+			{
+				m_Systems[i]->RestoreComponents(i < a_Snapshot.m_Components.size() ? a_Snapshot.m_Components[i].get() : nullptr);
+			}
+
+			// Everything recorded so far describes the world that was just replaced.
+			m_Events.Clear();
+			m_Events.Get<WorldRestoredEvent>().Push({});
+			return true;
+		}
+
+		uint32_t EntityComponentSystem::GetChangeTick() const
+		{
+			return m_ChangeTick.load(std::memory_order_relaxed);
+		}
+
+		uint32_t EntityComponentSystem::AdvanceChangeTick()
+		{
+			return m_ChangeTick.fetch_add(1, std::memory_order_acq_rel);
+		}
+
+		EntityID EntityComponentSystem::CreateEntity(const std::string& a_Name)
+		{
+			const EntityID id = ReserveEntity();
+			ActivateEntity(id, a_Name);
+			return id;
 		}
 
 		void EntityComponentSystem::Delete(const EntityID& a_ID)
 		{
-			m_EntitiesToDelete.push_back(a_ID);
+			GetCommandBuffer().DestroyEntity(a_ID);
+		}
+
+		EntityCommandBuffer& EntityComponentSystem::GetCommandBuffer()
+		{
+			struct ThreadBuffer
+			{
+				const EntityComponentSystem* m_Owner = nullptr;
+				EntityCommandBuffer* m_Buffer = nullptr;
+			};
+			thread_local ThreadBuffer threadBuffer;
+
+			if (threadBuffer.m_Owner != this)
+			{
+				std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+				m_CommandBuffers.push_back(std::make_unique<EntityCommandBuffer>(*this));
+				threadBuffer.m_Owner = this;
+				threadBuffer.m_Buffer = m_CommandBuffers.back().get();
+			}
+			return *threadBuffer.m_Buffer;
+		}
+
+		EntityID EntityComponentSystem::ReserveEntity()
+		{
+			std::shared_lock<std::shared_mutex> lock(m_ReserveMutex);
+
+			// Recycled indices first, only when those run out a fresh index is taken.
+			const size_t reserved = m_ReservedCount.fetch_add(1, std::memory_order_relaxed);
+			if (reserved < m_ReservableIDs.size())
+			{
+				return m_ReservableIDs[reserved];
+			}
+			return EntityID(m_NextIndex.fetch_add(1, std::memory_order_relaxed), 1);
+		}
+
+		void EntityComponentSystem::ReserveEntities(size_t a_Count, std::vector<EntityID>& a_IDs)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_ReserveMutex);
+
+			// One atomic add for the whole batch: recycled handles first, fresh indices for the rest.
+			const size_t first = m_ReservedCount.fetch_add(a_Count, std::memory_order_relaxed);
+			const size_t recycled = first < m_ReservableIDs.size() ? std::min(a_Count, m_ReservableIDs.size() - first) : 0;
+			if (recycled > 0)
+			{
+				a_IDs.insert(a_IDs.end(), m_ReservableIDs.begin() + first, m_ReservableIDs.begin() + first + recycled);
+			}
+
+			const uint32_t fresh = static_cast<uint32_t>(a_Count - recycled);
+			const uint32_t index = m_NextIndex.fetch_add(fresh, std::memory_order_relaxed);
+			for (uint32_t i = 0; i < fresh; i++)
+			{
+				a_IDs.emplace_back(index + i, 1);
+			}
+		}
+
+		std::vector<EntityID> EntityComponentSystem::Instantiate(const Prefab& a_Prefab, size_t a_Count, const graphics::dx12::Transform* a_Transforms)
+		{
+			std::vector<EntityID> ids;
+			if (a_Count == 0)
+			{
+				return ids;
+			}
+			ids.reserve(a_Count);
+			ReserveEntities(a_Count, ids);
+
+			uint32_t maxIndex = 0;
+			for (const EntityID& id : ids)
+			{
+				maxIndex = std::max(maxIndex, id.GetIndex());
+			}
+			if (maxIndex >= m_Generations.size())
+			{
+				m_Generations.resize(static_cast<size_t>(maxIndex) + 1, 1);
+				m_EntitySlots.resize(static_cast<size_t>(maxIndex) + 1, INVALID_SLOT);
+			}
+			m_Entities.reserve(m_Entities.size() + a_Count);
+			for (const EntityID& id : ids)
+			{
+				m_EntitySlots[id.GetIndex()] = static_cast<uint32_t>(m_Entities.size());
+				m_Entities.push_back(id);
+				m_CreatedEvents->Push({ id });
+			}
+
+			// All instances share the prefab name, so naming them does not allocate per instance.
+			EntityInfoComponent info;
+			if (const EntityInfoComponent* prefabInfo = a_Prefab.GetComponent<EntityInfoComponent>())
+			{
+				info = *prefabInfo;
+			}
+			info.SetName(a_Prefab.GetName());
+			GetSystem<EntityInfoSystem>().CreateComponents(ids.data(), ids.size(), info);
+
+			a_Prefab.CreateComponents(*this, ids.data(), ids.size());
+
+			if (a_Transforms)
+			{
+				TransformSystem& transformSystem = GetSystem<TransformSystem>();
+				transformSystem.CreateComponents(ids.data(), ids.size(), TransformComponent());
+				for (size_t i = 0; i < ids.size(); i++)
+				{
+					transformSystem.GetComponent(ids[i]).Transform() = a_Transforms[i];
+				}
+			}
+			return ids;
+		}
+
+		void EntityComponentSystem::ActivateEntity(const EntityID& a_ID, const std::string& a_Name)
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_Generations.size())
+			{
+				m_Generations.resize(static_cast<size_t>(index) + 1, 1);
+				m_EntitySlots.resize(static_cast<size_t>(index) + 1, INVALID_SLOT);
+			}
+
+			m_EntitySlots[index] = static_cast<uint32_t>(m_Entities.size());
+			m_Entities.push_back(a_ID);
+			m_CreatedEvents->Push({ a_ID });
+
+			GetSystem<EntityInfoSystem>().CreateComponent(a_ID).SetName(a_Name);
 		}
 
 		void EntityComponentSystem::DeleteEntity(const EntityID& a_ID)
 		{
+			// Deleting the same entity twice or deleting a stale handle does nothing.
+			if (!IsEntityValid(a_ID))
+			{
+				return;
+			}
+
 			for (auto& sys : m_Systems)
 			{
 				sys->DeleteComponent(a_ID);
 			}
-			m_Entities.erase(
-				std::remove_if(m_Entities.begin(), m_Entities.end(),
-				[&a_ID](const EntityID& entity)
-				{
-					return entity == a_ID;
-				}),
-				m_Entities.end());
+
+			// Move the last entity into the freed position.
+			const uint32_t index = a_ID.GetIndex();
+			const uint32_t slot = m_EntitySlots[index];
+			const EntityID last = m_Entities.back();
+			m_Entities[slot] = last;
+			m_EntitySlots[last.GetIndex()] = slot;
+			m_Entities.pop_back();
+			m_EntitySlots[index] = INVALID_SLOT;
+
+			// Tags go right away, component bits are cleared again when the systems remove the components.
+			m_Signatures.ClearEntity(a_ID);
+
+			// Bumping the generation invalidates every handle to this entity that is still around. Generation 0 is reserved for invalid handles.
+			if (++m_Generations[index] == 0)
+			{
+				m_Generations[index] = 1;
+			}
+			m_PendingFreeIndices.push_back(index);
+			m_DestroyedEvents->Push({ a_ID });
 		};
 
 		bool EntityComponentSystem::IsEntityValid(const EntityID& a_ID) const
 		{
-			return a_ID.IsValid();
+			const uint32_t index = a_ID.GetIndex();
+			return index < m_Generations.size() && m_EntitySlots[index] != INVALID_SLOT && m_Generations[index] == a_ID.GetGeneration();
+		}
+
+		const ComponentSignature& EntityComponentSystem::GetSignature(const EntityID& a_ID) const
+		{
+			return IsEntityValid(a_ID) ? m_Signatures.Get(a_ID) : EMPTY_SIGNATURE;
+		}
+
+		void EntityComponentSystem::SetTag(const EntityID& a_ID, size_t a_TagType, bool a_Add)
+		{
+			if (!IsEntityValid(a_ID))
+			{
+				return;
+			}
+
+			if (a_TagType >= MAX_COMPONENT_TYPES)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Tag type %i does not fit in a signature, raise MAX_COMPONENT_TYPES.", static_cast<int>(a_TagType));
+				return;
+			}
+
+			const bool changed = a_Add ? m_Signatures.Add(a_ID, a_TagType) : m_Signatures.Remove(a_ID, a_TagType);
+			if (changed)
+			{
+				m_Events.Get<EntityComponentsChangedEvent>().Push({ a_ID, a_TagType, a_Add });
+			}
+		}
+
+		void EntityComponentSystem::RegisterComponentOwner(AbstractECSSystem* a_System)
+		{
+			const size_t componentIndex = a_System->GetComponentTypeIndex();
+			if (componentIndex >= m_SystemsByComponentType.size())
+			{
+				m_SystemsByComponentType.resize(componentIndex + 1, nullptr);
+			}
+			if (m_SystemsByComponentType[componentIndex])
+			{
+				return;
+			}
+			m_SystemsByComponentType[componentIndex] = a_System;
+
+			// Without signatures the system is still found through its pool, only signature filters miss the type.
+			if (componentIndex >= MAX_COMPONENT_TYPES)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Component type %i does not fit in a signature, raise MAX_COMPONENT_TYPES.", static_cast<int>(componentIndex));
+				return;
+			}
+			a_System->SetSignatures(&m_Signatures);
 		}
 
 		void EntityComponentSystem::Clear()
@@ -141,55 +623,267 @@ namespace gallus
 
 		void EntityComponentSystem::ClearEntities()
 		{
-			m_Entities.clear();
+			while (!m_Entities.empty())
+			{
+				DeleteEntity(m_Entities.back());
+			}
+		}
+
+		AbstractECSSystem* EntityComponentSystem::GetComponentPoolOwner(size_t a_ComponentIndex, bool a_Multiple) const
+		{
+			if (a_ComponentIndex >= m_SystemsByComponentType.size() || !m_SystemsByComponentType[a_ComponentIndex])
+			{
+				return nullptr;
+			}
+
+			AbstractECSSystem* system = m_SystemsByComponentType[a_ComponentIndex];
+			return system->StoresMultipleComponents() == a_Multiple ? system : nullptr;
+		}
+
+		void EntityComponentSystem::LogMissingComponentSystem() const
+		{
+			LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Cannot create components, no system stores the component type with one component per entity.");
 		}
 
 		std::string EntityComponentSystem::GetUniqueName(const std::string& a_Name)
 		{
-			std::string name = a_Name;
+			return GetSystem<EntityInfoSystem>().GetUniqueName(a_Name);
+		}
+
+		EntityID EntityComponentSystem::FindEntityByName(const std::string& a_Name)
+		{
+			return GetSystem<EntityInfoSystem>().FindEntity(a_Name);
+		}
 
-			bool found = true;
-			int i = 0;
-			while (found)
+		std::vector<EntityID>& EntityComponentSystem::GetEntities()
+		{
+			return m_Entities;
+		}
+
+		EntityComponentSystem::SystemsContainingEntity EntityComponentSystem::GetSystemsContainingEntity(const EntityID& a_ID) const
+		{
+			return SystemsContainingEntity(m_Systems, a_ID, GetSignature(a_ID));
+		}
+
+		ECSEventBus& EntityComponentSystem::GetEvents()
+		{
+			return m_Events;
+		}
+
+		const SpatialIndex& EntityComponentSystem::GetSpatialIndex() const
+		{
+			return m_SpatialIndex;
+		}
+
+		void EntityComponentSystem::ExtractRenderList(graphics::dx12::RenderListBuffer& a_Lists)
+		{
+			graphics::dx12::RenderList& list = a_Lists.GetWriteList();
 			{
-				found = false;
-				for (EntityID& entity : m_Entities)
+				std::lock_guard<std::mutex> lock(m_EntityMutex);
+
+				list.m_Items.clear();
+				list.m_Frame = ++m_RenderFrame;
+				if (ComponentPool<MeshComponent>* meshes = GetComponentPool<MeshComponent>())
 				{
-					if (GetSystem<EntityInfoSystem>().GetComponent(entity).GetName() == name)
+					list.m_Items.reserve(meshes->size());
+				}
+
+				const TransformSystem& transformSystem = GetSystem<TransformSystem>();
+				View<const TransformComponent, const MeshComponent>().ForEach([&list, &transformSystem](const EntityID& a_ID, const TransformComponent&, const MeshComponent& a_MeshComponent)
+				{
+					graphics::dx12::RenderItem& item = list.m_Items.emplace_back();
+					DirectX::XMStoreFloat4x4(&item.m_WorldMatrix, transformSystem.GetWorldMatrix(a_ID));
+					item.m_Mesh = a_MeshComponent.GetMesh();
+					item.m_Shader = a_MeshComponent.GetShader();
+					item.m_Texture = a_MeshComponent.GetTexture();
+					item.m_Material = a_MeshComponent.GetMaterial();
+					item.m_ID = a_ID;
+				});
+			}
+			a_Lists.Publish();
+		}
+
+		void EntityComponentSystem::GetStats(ECSStats& a_Stats)
+		{
+			RecordPeakStats();
+
+			a_Stats.m_EntityCount = m_Entities.size();
+			a_Stats.m_EntityIndexCount = m_Generations.size();
+			a_Stats.m_PeakEntityCount = m_PeakEntityCount;
+			a_Stats.m_EntityTableBytes = m_Entities.capacity() * sizeof(EntityID) +
+				m_Generations.capacity() * sizeof(uint32_t) +
+				m_EntitySlots.capacity() * sizeof(uint32_t) +
+				m_Signatures.GetAllocatedBytes() +
+				m_PendingFreeIndices.capacity() * sizeof(uint32_t) +
+				m_ReservableIDs.capacity() * sizeof(EntityID);
+
+			{
+				std::shared_lock<std::shared_mutex> lock(m_ReserveMutex);
+				a_Stats.m_ReservedHandles = m_ReservedCount.load();
+				a_Stats.m_ReservableHandles = m_ReservableIDs.size() - std::min(a_Stats.m_ReservedHandles, m_ReservableIDs.size());
+			}
+
+			a_Stats.m_PendingCreates = 0;
+			a_Stats.m_PendingDestroys = 0;
+			a_Stats.m_PendingAdds = 0;
+			a_Stats.m_PendingRemoves = 0;
+			{
+				std::lock_guard<std::mutex> lock(m_CommandBufferMutex);
+				a_Stats.m_CommandBufferCount = m_CommandBuffers.size();
+				for (std::unique_ptr<EntityCommandBuffer>& buffer : m_CommandBuffers)
+				{
+					std::lock_guard<std::mutex> bufferLock(buffer->m_Mutex);
+					a_Stats.m_PendingCreates += buffer->m_Creates.size();
+					for (const EntityCommandBuffer::Command& command : buffer->m_Commands)
 					{
-						i++;
-						if (i != 0)
-						{
-							name = a_Name + " (" + std::to_string(i) + ")";
-							found = true;
-						}
+						a_Stats.m_PendingDestroys += command.m_Type == EntityCommandBuffer::CommandType::DestroyEntity;
+						a_Stats.m_PendingAdds += command.m_Type == EntityCommandBuffer::CommandType::AddComponent;
+						a_Stats.m_PendingRemoves += command.m_Type == EntityCommandBuffer::CommandType::RemoveComponent;
 					}
 				}
 			}
-			return name;
+
+			a_Stats.m_AllocatedBytes = a_Stats.m_EntityTableBytes;
+			a_Stats.m_LiveBytes = 0;
+			a_Stats.m_Systems.resize(m_Systems.size());
+			for (size_t i = 0; i < m_Systems.size(); i++)
+			{
+				SystemStats& stats = a_Stats.m_Systems[i];
+				m_Systems[i]->GetStats(stats);
+				stats.m_Name = m_Systems[i]->GetPropertyName();
+				stats.m_PeakComponentCount = m_SystemPeaks[i].m_ComponentCount;
+				stats.m_PeakAllocatedBytes = m_SystemPeaks[i].m_AllocatedBytes;
+				a_Stats.m_AllocatedBytes += stats.m_AllocatedBytes;
+				a_Stats.m_LiveBytes += stats.m_LiveBytes;
+			}
+
+			a_Stats.m_SpatialIndexCount = m_SpatialIndex.size();
+			a_Stats.m_SpatialIndexHeight = m_SpatialIndex.GetHeight();
+			a_Stats.m_SpatialIndexBytes = m_SpatialIndex.GetAllocatedBytes();
 		}
 
-		std::vector<EntityID>& EntityComponentSystem::GetEntities()
+		void EntityComponentSystem::ResetPeakStats()
 		{
-			return m_Entities;
+			m_SystemPeaks.clear();
+			m_PeakEntityCount = 0;
+			RecordPeakStats();
 		}
 
-		std::vector<AbstractECSSystem*> EntityComponentSystem::GetSystemsContainingEntity(const EntityID& a_ID)
+		void EntityComponentSystem::RecordPeakStats()
 		{
-			std::vector<AbstractECSSystem*> systems;
-			for (AbstractECSSystem* system : m_Systems)
+			m_PeakEntityCount = std::max(m_PeakEntityCount, m_Entities.size());
+
+			m_SystemPeaks.resize(m_Systems.size());
+			SystemStats stats;
+			for (size_t i = 0; i < m_Systems.size(); i++)
+			{
+				m_Systems[i]->GetStats(stats);
+				m_SystemPeaks[i].m_ComponentCount = std::max(m_SystemPeaks[i].m_ComponentCount, stats.m_ComponentCount);
+				m_SystemPeaks[i].m_AllocatedBytes = std::max(m_SystemPeaks[i].m_AllocatedBytes, stats.m_AllocatedBytes);
+			}
+		}
+
+		void EntityComponentSystem::UpdateSpatialIndex()
+		{
+			const TransformSystem& transformSystem = GetSystem<TransformSystem>();
+			MeshSystem& meshSystem = GetSystem<MeshSystem>();
+			const ComponentPool<TransformComponent>& transforms = transformSystem.GetComponents();
+			const ComponentPool<MeshComponent>& meshes = meshSystem.GetComponents();
+
+			auto getLocalBounds = [&meshes](const EntityID& a_ID)
 			{
-				if (system->ContainsID(a_ID))
+				const MeshComponent* meshComponent = meshes.TryGet(a_ID);
+				Bounds bounds;
+				if (meshComponent && meshComponent->GetMesh() && meshComponent->GetMesh()->GetBounds(bounds.m_Min, bounds.m_Max))
 				{
-					systems.push_back(system);
+					return bounds;
+				}
+				return DEFAULT_LOCAL_BOUNDS;
+			};
+			auto updateEntity = [this, &transformSystem, &getLocalBounds](const EntityID& a_ID)
+			{
+				DirectX::XMFLOAT4X4 world;
+				DirectX::XMStoreFloat4x4(&world, transformSystem.GetWorldMatrix(a_ID));
+				m_SpatialIndex.Update(a_ID, Bounds::Transform(getLocalBounds(a_ID), world));
+			};
+
+			// Removing a transform always changes the cache layout, so the index only has to be checked for stale entities then.
+			if (transformSystem.GetLayoutVersion() != m_SpatialLayoutVersion)
+			{
+				m_SpatialLayoutVersion = transformSystem.GetLayoutVersion();
+
+				std::vector<EntityID> removed;
+				m_SpatialIndex.ForEach([&transforms, &removed](const EntityID& a_ID, const Bounds&)
+				{
+					if (!transforms.Contains(a_ID))
+					{
+						removed.push_back(a_ID);
+					}
+				});
+				for (const EntityID& id : removed)
+				{
+					m_SpatialIndex.Remove(id);
 				}
 			}
-			return systems;
+
+			// Only the entities whose world matrix was recomputed can have moved.
+			m_SpatialIndex.BeginUpdate();
+			transformSystem.ForEachUpdatedWorldMatrix([this, &getLocalBounds](const EntityID& a_ID, const DirectX::XMFLOAT4X4& a_World)
+			{
+				m_SpatialIndex.Update(a_ID, Bounds::Transform(getLocalBounds(a_ID), a_World));
+			});
+
+			// Added, replaced and removed meshes change the bounds of entities that did not move. The mesh system records
+			// those, so only restoring all meshes needs a pass over every one of them.
+			if (meshSystem.HaveAllMeshesChanged())
+			{
+				for (size_t slot = 0; slot < meshes.size(); slot++)
+				{
+					if (m_SpatialIndex.Contains(meshes.GetEntity(slot)))
+					{
+						updateEntity(meshes.GetEntity(slot));
+					}
+				}
+			}
+			for (const EntityID& id : meshSystem.GetChangedMeshes())
+			{
+				if (m_SpatialIndex.Contains(id))
+				{
+					updateEntity(id);
+				}
+			}
+			meshSystem.ClearChangedMeshes();
+			m_SpatialIndex.EndUpdate();
 		}
 
-		std::vector<AbstractECSSystem*> EntityComponentSystem::GetSystems()
+		const std::vector<AbstractECSSystem*>& EntityComponentSystem::GetSystems() const
 		{
 			return m_Systems;
 		}
+
+		EntityComponentSystem::SystemsContainingEntity::Iterator::Iterator(AbstractECSSystem* const* a_Current, AbstractECSSystem* const* a_End, const EntityID& a_ID, const ComponentSignature& a_Signature) : m_Current(a_Current), m_End(a_End), m_ID(a_ID), m_Signature(&a_Signature)
+		{
+			SkipToMatch();
+		}
+
+		EntityComponentSystem::SystemsContainingEntity::Iterator& EntityComponentSystem::SystemsContainingEntity::Iterator::operator++()
+		{
+			++m_Current;
+			SkipToMatch();
+			return *this;
+		}
+
+		void EntityComponentSystem::SystemsContainingEntity::Iterator::SkipToMatch()
+		{
+			while (m_Current != m_End)
+			{
+				AbstractECSSystem* system = *m_Current;
+				if (system->UpdatesSignatures() ? m_Signature->Test(system->GetComponentTypeIndex()) : system->ContainsID(m_ID))
+				{
+					return;
+				}
+				++m_Current;
+			}
+		}
 	}
 }
\ No newline at end of file
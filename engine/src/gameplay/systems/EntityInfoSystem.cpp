@@ -1,5 +1,10 @@
 #include "gameplay/systems/EntityInfoSystem.h"
 
+#include <algorithm>
+#include <cstdlib>
+
+#include "gameplay/SceneSnapshot.h"
+
 #define JSON_ENTITY_DETAIL_COMPONENT_VAR "details"
 
 namespace gallus
@@ -10,5 +15,250 @@ namespace gallus
 		{
 			return JSON_ENTITY_DETAIL_COMPONENT_VAR;
 		}
+
+		bool EntityInfoSystem::WriteSnapshot(SnapshotWriter& a_Writer, uint32_t& a_Count) const
+		{
+			const ComponentPool<EntityInfoComponent>& pool = m_Components;
+			const size_t count = pool.size();
+
+			// Names are packed back to back, entry i spans [nameOffsets[i], nameOffsets[i + 1]).
+			std::vector<uint8_t> active(count);
+			std::vector<uint32_t> nameOffsets(count + 1, 0);
+			std::string names;
+			for (size_t i = 0; i < count; i++)
+			{
+				active[i] = pool[i].IsActive() ? 1 : 0;
+				names += pool[i].GetName();
+				nameOffsets[i + 1] = static_cast<uint32_t>(names.size());
+			}
+
+			a_Writer.WriteEntities(pool.GetEntities());
+			a_Writer.WriteColumn(active.data(), count);
+			a_Writer.WriteColumn(nameOffsets.data(), count + 1);
+			a_Writer.WriteBytes(names.data(), names.size());
+			a_Count = static_cast<uint32_t>(count);
+			return true;
+		}
+
+		bool EntityInfoSystem::ReadSnapshot(SnapshotReader& a_Reader, uint32_t a_Count)
+		{
+			const uint32_t* entities = a_Reader.ReadColumn<uint32_t>(a_Count);
+			const uint8_t* active = a_Reader.ReadColumn<uint8_t>(a_Count);
+			const uint32_t* nameOffsets = a_Reader.ReadColumn<uint32_t>(static_cast<size_t>(a_Count) + 1);
+			if (!entities || !active || !nameOffsets)
+			{
+				return false;
+			}
+
+			const char* names = reinterpret_cast<const char*>(a_Reader.ReadBytes(nameOffsets[a_Count]));
+			if (!names)
+			{
+				return false;
+			}
+
+			m_Components.Reserve(m_Components.size() + a_Count);
+			for (uint32_t i = 0; i < a_Count; i++)
+			{
+				const EntityID id = a_Reader.GetEntity(entities[i]);
+				if (!id.IsValid() || nameOffsets[i] > nameOffsets[i + 1] || nameOffsets[i + 1] > nameOffsets[a_Count])
+				{
+					continue;
+				}
+
+				EntityInfoComponent& component = CreateComponent(id);
+				component.SetIsActive(active[i] != 0);
+				component.SetName(std::string(names + nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i]));
+			}
+			return true;
+		}
+
+		size_t EntityInfoSystem::WriteDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince) const
+		{
+			return WriteComponentDelta(a_Writer, a_Baseline, a_ChangedSince, [](DeltaWriter& a_Writer, const EntityInfoComponent& a_Component, const EntityInfoComponent& a_Previous)
+			{
+				// The active flag only has two values, so a set bit means it flipped.
+				const bool active = a_Component.IsActive() != a_Previous.IsActive();
+				const bool name = a_Component.GetName() != a_Previous.GetName();
+				a_Writer.WriteBool(active);
+				a_Writer.WriteBool(name);
+				if (name)
+				{
+					a_Writer.WriteString(a_Component.GetName());
+				}
+				return active || name;
+			});
+		}
+
+		bool EntityInfoSystem::ReadDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures)
+		{
+			if (!a_State)
+			{
+				a_State = std::make_unique<EntityInfoPoolCopy>();
+			}
+
+			// A version the name index never had, so restoring the copy rebuilds the index.
+			static_cast<EntityInfoPoolCopy&>(*a_State).m_NameIndexVersion = m_NextNameIndexVersion++;
+			return ReadComponentDelta(a_Reader, a_State, a_Signatures, [this](DeltaReader& a_Reader, const EntityID& a_ID, EntityInfoComponent& a_Component)
+			{
+				if (a_Reader.ReadBool())
+				{
+					a_Component.SetIsActive(!a_Component.IsActive());
+				}
+				if (a_Reader.ReadBool())
+				{
+					// The copy is not part of this system yet, so the name index must not hear about the new name.
+					a_Component.SetOwner(a_ID, nullptr);
+					a_Component.SetName(a_Reader.ReadString());
+				}
+				a_Component.SetOwner(a_ID, this);
+				return true;
+			});
+		}
+
+		EntityID EntityInfoSystem::FindEntity(const std::string& a_Name) const
+		{
+			auto it = m_Names.find(a_Name);
+			if (it == m_Names.end() || it->second.empty())
+			{
+				return EntityID();
+			}
+			return it->second.front();
+		}
+
+		bool EntityInfoSystem::IsNameTaken(const std::string& a_Name) const
+		{
+			return m_Names.find(a_Name) != m_Names.end();
+		}
+
+		std::string EntityInfoSystem::GetUniqueName(const std::string& a_Name)
+		{
+			if (!IsNameTaken(a_Name))
+			{
+				return a_Name;
+			}
+
+			// Suffixes below the counter were taken the last time we looked, so the search continues from there.
+			uint32_t& suffix = m_NextSuffix.try_emplace(a_Name, 1).first->second;
+			std::string name = a_Name + " (" + std::to_string(suffix) + ")";
+			while (IsNameTaken(name))
+			{
+				suffix++;
+				name = a_Name + " (" + std::to_string(suffix) + ")";
+			}
+			suffix++;
+			return name;
+		}
+
+		void EntityInfoSystem::OnNameChanged(const EntityID& a_ID, const std::string& a_OldName, const std::string& a_NewName)
+		{
+			RemoveName(a_ID, a_OldName);
+			AddName(a_ID, a_NewName);
+		}
+
+		void EntityInfoSystem::SaveComponents(std::unique_ptr<AbstractComponentPoolCopy>& a_Copy) const
+		{
+			if (!a_Copy)
+			{
+				a_Copy = std::make_unique<EntityInfoPoolCopy>();
+			}
+			ECSBaseSystem::SaveComponents(a_Copy);
+			static_cast<EntityInfoPoolCopy&>(*a_Copy).m_NameIndexVersion = m_NameIndexVersion;
+		}
+
+		void EntityInfoSystem::RestoreComponents(const AbstractComponentPoolCopy* a_Copy)
+		{
+			ECSBaseSystem::RestoreComponents(a_Copy);
+
+			// The index still matches if no name was added, removed or changed since the copy was made.
+			const EntityInfoPoolCopy* copy = static_cast<const EntityInfoPoolCopy*>(a_Copy);
+			if (copy && copy->m_NameIndexVersion == m_NameIndexVersion)
+			{
+				return;
+			}
+
+			m_Names.clear();
+			m_NextSuffix.clear();
+			const ComponentPool<EntityInfoComponent>& pool = m_Components;
+			m_Names.reserve(pool.size());
+			for (size_t i = 0; i < pool.size(); i++)
+			{
+				AddName(pool.GetEntity(i), pool[i].GetName());
+			}
+			m_NameIndexVersion = copy ? copy->m_NameIndexVersion : m_NextNameIndexVersion++;
+		}
+
+		bool EntityInfoSystem::Destroy()
+		{
+			m_Names.clear();
+			m_NextSuffix.clear();
+			m_NameSlots.clear();
+			m_NameIndexVersion = m_NextNameIndexVersion++;
+			return ECSBaseSystem::Destroy();
+		}
+
+		void EntityInfoSystem::OnComponentAdded(const EntityID& a_ID, EntityInfoComponent& a_Component)
+		{
+			a_Component.SetOwner(a_ID, this);
+			AddName(a_ID, a_Component.GetName());
+		}
+
+		void EntityInfoSystem::OnComponentRemoved(const EntityID& a_ID, EntityInfoComponent& a_Component)
+		{
+			RemoveName(a_ID, a_Component.GetName());
+		}
+
+		void EntityInfoSystem::AddName(const EntityID& a_ID, const std::string& a_Name)
+		{
+			// Unnamed entities can not be looked up, keeping them out avoids one huge bucket.
+			if (a_Name.empty())
+			{
+				return;
+			}
+
+			std::vector<EntityID>& entities = m_Names[a_Name];
+			if (a_ID.GetIndex() >= m_NameSlots.size())
+			{
+				m_NameSlots.resize(static_cast<size_t>(a_ID.GetIndex()) + 1);
+			}
+			m_NameSlots[a_ID.GetIndex()] = static_cast<uint32_t>(entities.size());
+			entities.push_back(a_ID);
+			m_NameIndexVersion = m_NextNameIndexVersion++;
+		}
+
+		void EntityInfoSystem::RemoveName(const EntityID& a_ID, const std::string& a_Name)
+		{
+			auto it = m_Names.find(a_Name);
+			if (it == m_Names.end())
+			{
+				return;
+			}
+			m_NameIndexVersion = m_NextNameIndexVersion++;
+
+			// Swap with the last entity of the name, so many entities sharing a name can be removed in constant time.
+			std::vector<EntityID>& entities = it->second;
+			const uint32_t slot = a_ID.GetIndex() < m_NameSlots.size() ? m_NameSlots[a_ID.GetIndex()] : 0;
+			if (slot < entities.size() && entities[slot] == a_ID)
+			{
+				entities[slot] = entities.back();
+				m_NameSlots[entities[slot].GetIndex()] = slot;
+				entities.pop_back();
+			}
+			if (entities.empty())
+			{
+				m_Names.erase(it);
+
+				// A freed "name (n)" may be reused, so the counter of its base name has to look from there again.
+				const size_t open = a_Name.rfind(" (");
+				if (open != std::string::npos && a_Name.back() == ')')
+				{
+					auto suffix = m_NextSuffix.find(a_Name.substr(0, open));
+					if (suffix != m_NextSuffix.end())
+					{
+						const uint32_t number = static_cast<uint32_t>(std::strtoul(a_Name.c_str() + open + 2, nullptr, 10));
+						suffix->second = std::min(suffix->second, std::max(number, 1u));
+					}
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -6,14 +6,47 @@ namespace gallus
 {
 	namespace gameplay
 	{
-		std::map<EntityID, MeshComponent>& MeshSystem::GetComponents()
+		std::string MeshSystem::GetPropertyName() const
 		{
-			return m_Components;
+			return JSON_ENTITY_MESH_COMPONENT_VAR;
 		}
 
-		std::string MeshSystem::GetPropertyName() const
+		void MeshSystem::SetMesh(const EntityID& a_ID, graphics::dx12::Mesh& a_Mesh)
 		{
-			return JSON_ENTITY_MESH_COMPONENT_VAR;
+			GetComponent(a_ID).SetMesh(a_Mesh);
+			m_ChangedMeshes.push_back(a_ID);
+		}
+
+		const std::vector<EntityID>& MeshSystem::GetChangedMeshes() const
+		{
+			return m_ChangedMeshes;
+		}
+
+		bool MeshSystem::HaveAllMeshesChanged() const
+		{
+			return m_AllMeshesChanged;
+		}
+
+		void MeshSystem::ClearChangedMeshes()
+		{
+			m_ChangedMeshes.clear();
+			m_AllMeshesChanged = false;
+		}
+
+		void MeshSystem::OnComponentAdded(const EntityID& a_ID, MeshComponent& a_Component)
+		{
+			m_ChangedMeshes.push_back(a_ID);
+		}
+
+		void MeshSystem::OnComponentRemoved(const EntityID& a_ID, MeshComponent& a_Component)
+		{
+			m_ChangedMeshes.push_back(a_ID);
+		}
+
+		void MeshSystem::OnComponentsRestored()
+		{
+			m_ChangedMeshes.clear();
+			m_AllMeshesChanged = true;
 		}
 	}
 }
\ No newline at end of file
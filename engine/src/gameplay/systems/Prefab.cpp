@@ -0,0 +1,15 @@
+#include "gameplay/Prefab.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		void Prefab::CreateComponents(EntityComponentSystem& a_ECS, const EntityID* a_IDs, size_t a_Count) const
+		{
+			for (const std::unique_ptr<AbstractBlueprint>& blueprint : m_Blueprints)
+			{
+				blueprint->CreateComponents(a_ECS, a_IDs, a_Count);
+			}
+		}
+	}
+}
\ No newline at end of file
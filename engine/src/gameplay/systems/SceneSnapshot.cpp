@@ -0,0 +1,205 @@
+#include "gameplay/SceneSnapshot.h"
+
+#include <algorithm>
+
+#include "core/ReserveDataStream.h"
+#include "core/logger/Logger.h"
+
+#include "gameplay/EntityComponentSystem.h"
+#include "gameplay/ECSBaseSystem.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		namespace
+		{
+			void Align(core::ReserveDataStream& a_Stream)
+			{
+				static const unsigned char padding[SNAPSHOT_ALIGNMENT] = {};
+				const size_t remainder = a_Stream.Tell() % SNAPSHOT_ALIGNMENT;
+				if (remainder != 0)
+				{
+					a_Stream.Write(padding, SNAPSHOT_ALIGNMENT - remainder);
+				}
+			}
+		}
+
+		uint32_t SnapshotWriter::GetOrdinal(const EntityID& a_ID) const
+		{
+			if (!a_ID.IsValid() || a_ID.GetIndex() >= m_Ordinals.size())
+			{
+				return SNAPSHOT_NO_ENTITY;
+			}
+
+			// Stale handles share the index with a live entity, the generation tells them apart.
+			const uint32_t ordinal = m_Ordinals[a_ID.GetIndex()];
+			return ordinal != SNAPSHOT_NO_ENTITY && m_Entities[ordinal] == a_ID ? ordinal : SNAPSHOT_NO_ENTITY;
+		}
+
+		void SnapshotWriter::WriteEntities(const std::vector<EntityID>& a_Entities)
+		{
+			std::vector<uint32_t> ordinals(a_Entities.size());
+			for (size_t i = 0; i < a_Entities.size(); i++)
+			{
+				ordinals[i] = GetOrdinal(a_Entities[i]);
+			}
+			WriteColumn(ordinals.data(), ordinals.size());
+		}
+
+		void SnapshotWriter::WriteBytes(const void* a_Data, size_t a_Size)
+		{
+			Align(m_Stream);
+			if (a_Size > 0)
+			{
+				m_Stream.Write(a_Data, a_Size);
+			}
+		}
+
+		const unsigned char* SnapshotReader::ReadBytes(size_t a_Size)
+		{
+			const size_t misalignment = reinterpret_cast<uintptr_t>(m_Current) % SNAPSHOT_ALIGNMENT;
+			const unsigned char* column = misalignment != 0 ? m_Current + (SNAPSHOT_ALIGNMENT - misalignment) : m_Current;
+			if (column > m_End || static_cast<size_t>(m_End - column) < a_Size)
+			{
+				return nullptr;
+			}
+			m_Current = column + a_Size;
+			return column;
+		}
+
+		bool SceneSnapshot::Save(EntityComponentSystem& a_ECS, core::ReserveDataStream& a_Stream)
+		{
+			const size_t start = a_Stream.Tell();
+			if (start % SNAPSHOT_ALIGNMENT != 0)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot has to start at an aligned position in the stream.");
+				return false;
+			}
+
+			// Entities are stored by ordinal, so the snapshot does not depend on the indices of this world.
+			const std::vector<EntityID>& entities = a_ECS.GetEntities();
+			std::vector<uint32_t> ordinals;
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				const uint32_t index = entities[i].GetIndex();
+				if (index >= ordinals.size())
+				{
+					ordinals.resize(static_cast<size_t>(index) + 1, SNAPSHOT_NO_ENTITY);
+				}
+				ordinals[index] = static_cast<uint32_t>(i);
+			}
+
+			SnapshotHeader header;
+			header.m_EntityCount = static_cast<uint32_t>(entities.size());
+			a_Stream.Write(&header, sizeof(header));
+
+			SnapshotWriter writer(a_Stream, entities, ordinals);
+			std::vector<SnapshotBlock> blocks;
+			for (AbstractECSSystem* system : a_ECS.GetSystems())
+			{
+				Align(a_Stream);
+
+				SnapshotBlock block;
+				block.m_Offset = a_Stream.Tell() - start;
+				uint32_t count = 0;
+				if (!system->WriteSnapshot(writer, count))
+				{
+					continue;
+				}
+
+				const std::string name = system->GetPropertyName();
+				memcpy(block.m_Name, name.c_str(), std::min(name.size(), sizeof(block.m_Name) - 1));
+				block.m_Count = count;
+				block.m_Size = (a_Stream.Tell() - start) - block.m_Offset;
+				blocks.push_back(block);
+			}
+
+			Align(a_Stream);
+			header.m_BlockCount = static_cast<uint32_t>(blocks.size());
+			header.m_DirectoryOffset = a_Stream.Tell() - start;
+			if (!blocks.empty())
+			{
+				a_Stream.Write(blocks.data(), sizeof(SnapshotBlock) * blocks.size());
+			}
+
+			// Patch the header now that the directory is known.
+			const size_t end = a_Stream.Tell();
+			a_Stream.Seek(start, SEEK_SET);
+			a_Stream.Write(&header, sizeof(header));
+			a_Stream.Seek(end, SEEK_SET);
+			return true;
+		}
+
+		bool SceneSnapshot::Load(EntityComponentSystem& a_ECS, const void* a_Data, size_t a_Size)
+		{
+			const unsigned char* begin = reinterpret_cast<const unsigned char*>(a_Data);
+			if (reinterpret_cast<uintptr_t>(begin) % SNAPSHOT_ALIGNMENT != 0)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot data is not aligned.");
+				return false;
+			}
+
+			SnapshotHeader header;
+			if (a_Size < sizeof(header))
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot is too small.");
+				return false;
+			}
+			memcpy(&header, begin, sizeof(header));
+			if (header.m_Magic != SNAPSHOT_MAGIC || header.m_Version != SNAPSHOT_VERSION)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot has an unknown format or version.");
+				return false;
+			}
+			if (header.m_DirectoryOffset > a_Size || (a_Size - header.m_DirectoryOffset) / sizeof(SnapshotBlock) < header.m_BlockCount)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot block directory is out of bounds.");
+				return false;
+			}
+
+			std::vector<EntityID> entities(header.m_EntityCount);
+			a_ECS.GetEntities().reserve(a_ECS.GetEntities().size() + header.m_EntityCount);
+			for (uint32_t i = 0; i < header.m_EntityCount; i++)
+			{
+				entities[i] = a_ECS.CreateEntity("");
+			}
+
+			const SnapshotBlock* directory = reinterpret_cast<const SnapshotBlock*>(begin + header.m_DirectoryOffset);
+			for (uint32_t i = 0; i < header.m_BlockCount; i++)
+			{
+				const SnapshotBlock& block = directory[i];
+				if (block.m_Offset > a_Size || a_Size - block.m_Offset < block.m_Size)
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Snapshot block is out of bounds.");
+					return false;
+				}
+
+				const std::string name(block.m_Name, strnlen(block.m_Name, sizeof(block.m_Name)));
+				AbstractECSSystem* target = nullptr;
+				for (AbstractECSSystem* system : a_ECS.GetSystems())
+				{
+					if (system->GetPropertyName() == name)
+					{
+						target = system;
+						break;
+					}
+				}
+
+				if (!target)
+				{
+					LOGF(LOGSEVERITY_WARNING, LOG_CATEGORY_ECS, "Skipping snapshot block %s, no system reads it.", name.c_str());
+					continue;
+				}
+
+				SnapshotReader reader(begin + block.m_Offset, begin + block.m_Offset + block.m_Size, entities);
+				if (!target->ReadSnapshot(reader, block.m_Count))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed reading snapshot block %s.", name.c_str());
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,722 @@
+#include "gameplay/SpatialIndex.h"
+
+#include <cmath>
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Moving entities get their bounds stretched this many frames ahead in the direction they moved.
+		/// </summary>
+		constexpr float DISPLACEMENT_MULTIPLIER = 4.0f;
+
+		/// <summary>
+		/// A batch rebuilds the tree when more than this share of the entities has to be inserted. Inserting one entity
+		/// costs about as much as rebuilding the tree for a few entities.
+		/// </summary>
+		constexpr size_t REBUILD_DIVISOR = 4;
+
+		static float GetAxis(const DirectX::XMFLOAT3& a_Vector, int a_Axis)
+		{
+			return a_Axis == 0 ? a_Vector.x : (a_Axis == 1 ? a_Vector.y : a_Vector.z);
+		}
+
+		static DirectX::XMFLOAT3 GetCenter(const Bounds& a_Bounds)
+		{
+			return DirectX::XMFLOAT3(
+				(a_Bounds.m_Min.x + a_Bounds.m_Max.x) * 0.5f,
+				(a_Bounds.m_Min.y + a_Bounds.m_Max.y) * 0.5f,
+				(a_Bounds.m_Min.z + a_Bounds.m_Max.z) * 0.5f);
+		}
+
+		static Bounds Grow(const Bounds& a_Bounds, float a_Margin)
+		{
+			return {
+				{ a_Bounds.m_Min.x - a_Margin, a_Bounds.m_Min.y - a_Margin, a_Bounds.m_Min.z - a_Margin },
+				{ a_Bounds.m_Max.x + a_Margin, a_Bounds.m_Max.y + a_Margin, a_Bounds.m_Max.z + a_Margin }
+			};
+		}
+
+		/// <summary>
+		/// Grows bounds by a margin and stretches them along a displacement.
+		/// </summary>
+		/// <param name="a_Bounds">The bounds.</param>
+		/// <param name="a_Margin">The margin on every side.</param>
+		/// <param name="a_Displacement">How far the bounds moved since the last update.</param>
+		/// <returns>The enlarged bounds.</returns>
+		static Bounds Enlarge(const Bounds& a_Bounds, float a_Margin, const DirectX::XMFLOAT3& a_Displacement)
+		{
+			Bounds bounds = Grow(a_Bounds, a_Margin);
+			const DirectX::XMFLOAT3 stretch(a_Displacement.x * DISPLACEMENT_MULTIPLIER, a_Displacement.y * DISPLACEMENT_MULTIPLIER, a_Displacement.z * DISPLACEMENT_MULTIPLIER);
+			(stretch.x < 0.0f ? bounds.m_Min.x : bounds.m_Max.x) += stretch.x;
+			(stretch.y < 0.0f ? bounds.m_Min.y : bounds.m_Max.y) += stretch.y;
+			(stretch.z < 0.0f ? bounds.m_Min.z : bounds.m_Max.z) += stretch.z;
+			return bounds;
+		}
+
+		Bounds Bounds::Transform(const Bounds& a_Local, const DirectX::XMFLOAT4X4& a_World)
+		{
+			// Row vectors, so the rows of the matrix are the transformed axes and the last row is the translation.
+			const DirectX::XMFLOAT3 center = GetCenter(a_Local);
+			const DirectX::XMFLOAT3 extents(
+				(a_Local.m_Max.x - a_Local.m_Min.x) * 0.5f,
+				(a_Local.m_Max.y - a_Local.m_Min.y) * 0.5f,
+				(a_Local.m_Max.z - a_Local.m_Min.z) * 0.5f);
+
+			const DirectX::XMFLOAT3 worldCenter(
+				center.x * a_World._11 + center.y * a_World._21 + center.z * a_World._31 + a_World._41,
+				center.x * a_World._12 + center.y * a_World._22 + center.z * a_World._32 + a_World._42,
+				center.x * a_World._13 + center.y * a_World._23 + center.z * a_World._33 + a_World._43);
+			const DirectX::XMFLOAT3 worldExtents(
+				extents.x * std::fabs(a_World._11) + extents.y * std::fabs(a_World._21) + extents.z * std::fabs(a_World._31),
+				extents.x * std::fabs(a_World._12) + extents.y * std::fabs(a_World._22) + extents.z * std::fabs(a_World._32),
+				extents.x * std::fabs(a_World._13) + extents.y * std::fabs(a_World._23) + extents.z * std::fabs(a_World._33));
+
+			return {
+				{ worldCenter.x - worldExtents.x, worldCenter.y - worldExtents.y, worldCenter.z - worldExtents.z },
+				{ worldCenter.x + worldExtents.x, worldCenter.y + worldExtents.y, worldCenter.z + worldExtents.z }
+			};
+		}
+
+		Frustum Frustum::FromViewProjection(const DirectX::XMMATRIX& a_ViewProjection)
+		{
+			DirectX::XMFLOAT4X4 m;
+			DirectX::XMStoreFloat4x4(&m, a_ViewProjection);
+
+			// Clip space coordinates are the dot products with the columns, the planes are where they reach the edges of the clip volume.
+			// Depth runs from 0 to 1, so the near plane is the third column by itself.
+			Frustum frustum;
+			frustum.m_Planes[0] = DirectX::XMFLOAT4(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41); // Left.
+			frustum.m_Planes[1] = DirectX::XMFLOAT4(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41); // Right.
+			frustum.m_Planes[2] = DirectX::XMFLOAT4(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42); // Bottom.
+			frustum.m_Planes[3] = DirectX::XMFLOAT4(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42); // Top.
+			frustum.m_Planes[4] = DirectX::XMFLOAT4(m._13, m._23, m._33, m._43); // Near.
+			frustum.m_Planes[5] = DirectX::XMFLOAT4(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43); // Far.
+
+			for (DirectX::XMFLOAT4& plane : frustum.m_Planes)
+			{
+				const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+				if (length > 0.0f)
+				{
+					plane.x /= length;
+					plane.y /= length;
+					plane.z /= length;
+					plane.w /= length;
+				}
+			}
+			return frustum;
+		}
+
+		bool SpatialIndex::Update(const EntityID& a_ID, const Bounds& a_Bounds)
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_Leaves.size())
+			{
+				m_Leaves.resize(static_cast<size_t>(index) + 1, INVALID_NODE);
+			}
+
+			uint32_t leaf = m_Leaves[index];
+			if (leaf != INVALID_NODE)
+			{
+				Node& node = m_Nodes[leaf];
+				const DirectX::XMFLOAT3 oldCenter = GetCenter(node.m_Tight);
+				const DirectX::XMFLOAT3 newCenter = GetCenter(a_Bounds);
+				const Bounds enlarged = Enlarge(a_Bounds, m_Margin, DirectX::XMFLOAT3(newCenter.x - oldCenter.x, newCenter.y - oldCenter.y, newCenter.z - oldCenter.z));
+
+				// A recycled index takes over the entry of the entity that used it before.
+				node.m_ID = a_ID;
+				node.m_Tight = a_Bounds;
+
+				// Entries are only moved when the entity left them, or when they became much larger than needed.
+				if (node.m_Bounds.Contains(a_Bounds) && Grow(enlarged, 4.0f * m_Margin).Contains(node.m_Bounds))
+				{
+					return false;
+				}
+
+				// Within a batch the leaf stays where it is until EndUpdate, nothing is queried until then.
+				if (m_Batching)
+				{
+					node.m_Bounds = enlarged;
+					if (!node.m_Pending)
+					{
+						node.m_Pending = true;
+						m_Pending.push_back(leaf);
+					}
+					return true;
+				}
+
+				RemoveLeaf(leaf);
+				m_Nodes[leaf].m_Bounds = enlarged;
+				InsertLeaf(leaf);
+				return true;
+			}
+
+			leaf = AllocateNode();
+			Node& node = m_Nodes[leaf];
+			node.m_Bounds = Grow(a_Bounds, m_Margin);
+			node.m_Tight = a_Bounds;
+			node.m_ID = a_ID;
+			m_Leaves[index] = leaf;
+			m_LeafCount++;
+			if (m_Batching)
+			{
+				node.m_Pending = true;
+				m_Pending.push_back(leaf);
+			}
+			else
+			{
+				InsertLeaf(leaf);
+			}
+			return true;
+		}
+
+		void SpatialIndex::BeginUpdate()
+		{
+			m_Batching = true;
+		}
+
+		void SpatialIndex::EndUpdate()
+		{
+			m_Batching = false;
+			if (m_Pending.size() > m_LeafCount / REBUILD_DIVISOR)
+			{
+				m_Pending.clear();
+				Rebuild();
+				return;
+			}
+
+			for (uint32_t leaf : m_Pending)
+			{
+				// Leaves removed during the batch are skipped, reused ones are only in the list once with the flag set.
+				Node& node = m_Nodes[leaf];
+				if (!node.IsLeaf() || !node.m_Pending)
+				{
+					continue;
+				}
+
+				node.m_Pending = false;
+				if (IsInTree(leaf))
+				{
+					RemoveLeaf(leaf);
+				}
+				InsertLeaf(leaf);
+			}
+			m_Pending.clear();
+		}
+
+		bool SpatialIndex::Remove(const EntityID& a_ID)
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_Leaves.size() || m_Leaves[index] == INVALID_NODE || m_Nodes[m_Leaves[index]].m_ID != a_ID)
+			{
+				return false;
+			}
+
+			const uint32_t leaf = m_Leaves[index];
+			if (IsInTree(leaf))
+			{
+				RemoveLeaf(leaf);
+			}
+			FreeNode(leaf);
+			m_Leaves[index] = INVALID_NODE;
+			m_LeafCount--;
+			return true;
+		}
+
+		void SpatialIndex::Clear()
+		{
+			m_Nodes.clear();
+			m_Leaves.clear();
+			m_Root = INVALID_NODE;
+			m_FreeList = INVALID_NODE;
+			m_Pending.clear();
+			m_LeafCount = 0;
+		}
+
+		void SpatialIndex::Rebuild()
+		{
+			// The centers are gathered once, so splitting only touches this array and not the nodes.
+			std::vector<BuildEntry> entries;
+			entries.reserve(m_LeafCount);
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_Nodes.size()); i++)
+			{
+				Node& node = m_Nodes[i];
+				if (node.IsLeaf())
+				{
+					node.m_Pending = false;
+					entries.push_back({ GetCenter(node.m_Bounds), i });
+				}
+				else if (node.m_Height > 0)
+				{
+					FreeNode(i);
+				}
+			}
+
+			m_Root = entries.empty() ? INVALID_NODE : Build(entries.data(), entries.size());
+			if (m_Root != INVALID_NODE)
+			{
+				m_Nodes[m_Root].m_Parent = INVALID_NODE;
+			}
+		}
+
+		bool SpatialIndex::Contains(const EntityID& a_ID) const
+		{
+			return GetBounds(a_ID) != nullptr;
+		}
+
+		const Bounds* SpatialIndex::GetBounds(const EntityID& a_ID) const
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_Leaves.size() || m_Leaves[index] == INVALID_NODE)
+			{
+				return nullptr;
+			}
+
+			const Node& node = m_Nodes[m_Leaves[index]];
+			return node.m_ID == a_ID ? &node.m_Tight : nullptr;
+		}
+
+		uint32_t SpatialIndex::GetHeight() const
+		{
+			return m_Root == INVALID_NODE ? 0 : static_cast<uint32_t>(m_Nodes[m_Root].m_Height) + 1;
+		}
+
+		bool SpatialIndex::RaycastClosest(const Ray& a_Ray, float a_MaxDistance, RaycastHit& a_Hit) const
+		{
+			if (m_Root == INVALID_NODE)
+			{
+				return false;
+			}
+
+			const DirectX::XMFLOAT3 inverseDirection = GetInverseDirection(a_Ray);
+			auto getBounds = [](const Node& a_Node) -> const Bounds&
+			{
+				return a_Node.IsLeaf() ? a_Node.m_Tight : a_Node.m_Bounds;
+			};
+
+			float closest = a_MaxDistance;
+			bool found = false;
+			TraversalStack stack;
+			stack.Push(m_Root);
+			while (!stack.IsEmpty())
+			{
+				const Node& node = m_Nodes[stack.Pop()];
+
+				// Tested again when popped, a closer hit may have been found since the node was pushed.
+				float distance = 0.0f;
+				if (!IntersectRay(getBounds(node), a_Ray.m_Origin, inverseDirection, closest, distance))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					closest = distance;
+					a_Hit.m_ID = node.m_ID;
+					a_Hit.m_Distance = distance;
+					found = true;
+					continue;
+				}
+
+				// The nearer child is pushed last, so it is visited first and can cut off the other one.
+				float leftDistance = 0.0f, rightDistance = 0.0f;
+				const bool hitLeft = IntersectRay(getBounds(m_Nodes[node.m_Left]), a_Ray.m_Origin, inverseDirection, closest, leftDistance);
+				const bool hitRight = IntersectRay(getBounds(m_Nodes[node.m_Right]), a_Ray.m_Origin, inverseDirection, closest, rightDistance);
+				if (hitLeft && hitRight)
+				{
+					const bool leftFirst = leftDistance <= rightDistance;
+					stack.Push(leftFirst ? node.m_Right : node.m_Left);
+					stack.Push(leftFirst ? node.m_Left : node.m_Right);
+				}
+				else if (hitLeft)
+				{
+					stack.Push(node.m_Left);
+				}
+				else if (hitRight)
+				{
+					stack.Push(node.m_Right);
+				}
+			}
+			return found;
+		}
+
+		float SpatialIndex::GetDistanceSq(const Bounds& a_Bounds, const DirectX::XMFLOAT3& a_Point)
+		{
+			const float x = std::max({ a_Bounds.m_Min.x - a_Point.x, 0.0f, a_Point.x - a_Bounds.m_Max.x });
+			const float y = std::max({ a_Bounds.m_Min.y - a_Point.y, 0.0f, a_Point.y - a_Bounds.m_Max.y });
+			const float z = std::max({ a_Bounds.m_Min.z - a_Point.z, 0.0f, a_Point.z - a_Bounds.m_Max.z });
+			return x * x + y * y + z * z;
+		}
+
+		SpatialIndex::FrustumResult SpatialIndex::Classify(const Frustum& a_Frustum, const Bounds& a_Bounds)
+		{
+			FrustumResult result = FrustumResult::Inside;
+			for (const DirectX::XMFLOAT4& plane : a_Frustum.m_Planes)
+			{
+				// The corner furthest along the plane normal decides whether the box is outside, the nearest one whether it is inside.
+				const float furthest = plane.x * (plane.x >= 0.0f ? a_Bounds.m_Max.x : a_Bounds.m_Min.x) +
+					plane.y * (plane.y >= 0.0f ? a_Bounds.m_Max.y : a_Bounds.m_Min.y) +
+					plane.z * (plane.z >= 0.0f ? a_Bounds.m_Max.z : a_Bounds.m_Min.z) + plane.w;
+				if (furthest < 0.0f)
+				{
+					return FrustumResult::Outside;
+				}
+
+				const float nearest = plane.x * (plane.x >= 0.0f ? a_Bounds.m_Min.x : a_Bounds.m_Max.x) +
+					plane.y * (plane.y >= 0.0f ? a_Bounds.m_Min.y : a_Bounds.m_Max.y) +
+					plane.z * (plane.z >= 0.0f ? a_Bounds.m_Min.z : a_Bounds.m_Max.z) + plane.w;
+				if (nearest < 0.0f)
+				{
+					result = FrustumResult::Intersecting;
+				}
+			}
+			return result;
+		}
+
+		DirectX::XMFLOAT3 SpatialIndex::GetInverseDirection(const Ray& a_Ray)
+		{
+			// Axes the ray runs parallel to become infinite, which the slab test handles without a special case.
+			return DirectX::XMFLOAT3(1.0f / a_Ray.m_Direction.x, 1.0f / a_Ray.m_Direction.y, 1.0f / a_Ray.m_Direction.z);
+		}
+
+		bool SpatialIndex::IntersectRay(const Bounds& a_Bounds, const DirectX::XMFLOAT3& a_Origin, const DirectX::XMFLOAT3& a_InverseDirection, float a_MaxDistance, float& a_Distance)
+		{
+			float enter = 0.0f;
+			float exit = a_MaxDistance;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float origin = GetAxis(a_Origin, axis);
+				const float inverse = GetAxis(a_InverseDirection, axis);
+				float slabEnter = (GetAxis(a_Bounds.m_Min, axis) - origin) * inverse;
+				float slabExit = (GetAxis(a_Bounds.m_Max, axis) - origin) * inverse;
+				if (slabEnter > slabExit)
+				{
+					std::swap(slabEnter, slabExit);
+				}
+
+				// Written so that a NaN from a ray starting on a slab leaves the interval as it is.
+				enter = slabEnter > enter ? slabEnter : enter;
+				exit = slabExit < exit ? slabExit : exit;
+				if (enter > exit)
+				{
+					return false;
+				}
+			}
+
+			a_Distance = enter;
+			return true;
+		}
+
+		bool SpatialIndex::IsInTree(uint32_t a_Leaf) const
+		{
+			return m_Nodes[a_Leaf].m_Parent != INVALID_NODE || m_Root == a_Leaf;
+		}
+
+		uint32_t SpatialIndex::AllocateNode()
+		{
+			uint32_t node = m_FreeList;
+			if (node == INVALID_NODE)
+			{
+				node = static_cast<uint32_t>(m_Nodes.size());
+				m_Nodes.emplace_back();
+			}
+			else
+			{
+				m_FreeList = m_Nodes[node].m_Parent;
+				m_Nodes[node] = Node();
+			}
+			return node;
+		}
+
+		void SpatialIndex::FreeNode(uint32_t a_Node)
+		{
+			Node& node = m_Nodes[a_Node];
+			node.m_Parent = m_FreeList;
+			node.m_Left = INVALID_NODE;
+			node.m_Right = INVALID_NODE;
+			node.m_Height = -1;
+			node.m_Pending = false;
+			m_FreeList = a_Node;
+		}
+
+		void SpatialIndex::InsertLeaf(uint32_t a_Leaf)
+		{
+			if (m_Root == INVALID_NODE)
+			{
+				m_Root = a_Leaf;
+				m_Nodes[a_Leaf].m_Parent = INVALID_NODE;
+				return;
+			}
+
+			// Walk down to the sibling that grows the tree the least. Every branch on the way grows to contain the leaf,
+			// which is counted as the inherited cost.
+			const Bounds leafBounds = m_Nodes[a_Leaf].m_Bounds;
+			uint32_t index = m_Root;
+			while (!m_Nodes[index].IsLeaf())
+			{
+				const Node& node = m_Nodes[index];
+				const float area = node.m_Bounds.GetHalfArea();
+				const float combinedArea = node.m_Bounds.Merge(leafBounds).GetHalfArea();
+
+				// Cost of making a new parent for this node and the leaf.
+				const float cost = 2.0f * combinedArea;
+				const float inheritedCost = 2.0f * (combinedArea - area);
+
+				auto getDescendCost = [this, &leafBounds, inheritedCost](uint32_t a_Child)
+				{
+					const Node& child = m_Nodes[a_Child];
+					const float mergedArea = child.m_Bounds.Merge(leafBounds).GetHalfArea();
+					return (child.IsLeaf() ? mergedArea : mergedArea - child.m_Bounds.GetHalfArea()) + inheritedCost;
+				};
+				const float leftCost = getDescendCost(node.m_Left);
+				const float rightCost = getDescendCost(node.m_Right);
+
+				if (cost < leftCost && cost < rightCost)
+				{
+					break;
+				}
+				index = leftCost < rightCost ? node.m_Left : node.m_Right;
+			}
+
+			const uint32_t sibling = index;
+			const uint32_t oldParent = m_Nodes[sibling].m_Parent;
+			const uint32_t newParent = AllocateNode();
+			{
+				Node& parent = m_Nodes[newParent];
+				parent.m_Parent = oldParent;
+				parent.m_Bounds = leafBounds.Merge(m_Nodes[sibling].m_Bounds);
+				parent.m_Height = m_Nodes[sibling].m_Height + 1;
+				parent.m_Left = sibling;
+				parent.m_Right = a_Leaf;
+			}
+			m_Nodes[sibling].m_Parent = newParent;
+			m_Nodes[a_Leaf].m_Parent = newParent;
+
+			if (oldParent == INVALID_NODE)
+			{
+				m_Root = newParent;
+			}
+			else if (m_Nodes[oldParent].m_Left == sibling)
+			{
+				m_Nodes[oldParent].m_Left = newParent;
+			}
+			else
+			{
+				m_Nodes[oldParent].m_Right = newParent;
+			}
+
+			// Refit and rebalance the branches above the leaf.
+			index = m_Nodes[a_Leaf].m_Parent;
+			while (index != INVALID_NODE)
+			{
+				index = Balance(index);
+
+				Node& node = m_Nodes[index];
+				node.m_Height = 1 + std::max(m_Nodes[node.m_Left].m_Height, m_Nodes[node.m_Right].m_Height);
+				node.m_Bounds = m_Nodes[node.m_Left].m_Bounds.Merge(m_Nodes[node.m_Right].m_Bounds);
+				index = node.m_Parent;
+			}
+		}
+
+		void SpatialIndex::RemoveLeaf(uint32_t a_Leaf)
+		{
+			if (a_Leaf == m_Root)
+			{
+				m_Root = INVALID_NODE;
+				return;
+			}
+
+			// The sibling takes the place of the parent.
+			const uint32_t parent = m_Nodes[a_Leaf].m_Parent;
+			const uint32_t grandParent = m_Nodes[parent].m_Parent;
+			const uint32_t sibling = m_Nodes[parent].m_Left == a_Leaf ? m_Nodes[parent].m_Right : m_Nodes[parent].m_Left;
+			FreeNode(parent);
+
+			m_Nodes[sibling].m_Parent = grandParent;
+			if (grandParent == INVALID_NODE)
+			{
+				m_Root = sibling;
+				return;
+			}
+
+			if (m_Nodes[grandParent].m_Left == parent)
+			{
+				m_Nodes[grandParent].m_Left = sibling;
+			}
+			else
+			{
+				m_Nodes[grandParent].m_Right = sibling;
+			}
+
+			uint32_t index = grandParent;
+			while (index != INVALID_NODE)
+			{
+				index = Balance(index);
+
+				Node& node = m_Nodes[index];
+				node.m_Height = 1 + std::max(m_Nodes[node.m_Left].m_Height, m_Nodes[node.m_Right].m_Height);
+				node.m_Bounds = m_Nodes[node.m_Left].m_Bounds.Merge(m_Nodes[node.m_Right].m_Bounds);
+				index = node.m_Parent;
+			}
+		}
+
+		uint32_t SpatialIndex::Balance(uint32_t a_Node)
+		{
+			const uint32_t iA = a_Node;
+			Node& a = m_Nodes[iA];
+			if (a.IsLeaf() || a.m_Height < 2)
+			{
+				return iA;
+			}
+
+			const uint32_t iB = a.m_Left;
+			const uint32_t iC = a.m_Right;
+			Node& b = m_Nodes[iB];
+			Node& c = m_Nodes[iC];
+
+			// Replaces A by one of its children in the parent of A.
+			auto replaceInParent = [this, &a, iA](uint32_t a_Replacement)
+			{
+				if (a.m_Parent == INVALID_NODE)
+				{
+					m_Root = a_Replacement;
+				}
+				else if (m_Nodes[a.m_Parent].m_Left == iA)
+				{
+					m_Nodes[a.m_Parent].m_Left = a_Replacement;
+				}
+				else
+				{
+					m_Nodes[a.m_Parent].m_Right = a_Replacement;
+				}
+			};
+
+			const int32_t balance = c.m_Height - b.m_Height;
+
+			// C is too high, C becomes the parent of A and A takes over the lower child of C.
+			if (balance > 1)
+			{
+				const uint32_t iF = c.m_Left;
+				const uint32_t iG = c.m_Right;
+				Node& f = m_Nodes[iF];
+				Node& g = m_Nodes[iG];
+
+				c.m_Left = iA;
+				c.m_Parent = a.m_Parent;
+				replaceInParent(iC);
+				a.m_Parent = iC;
+
+				if (f.m_Height > g.m_Height)
+				{
+					c.m_Right = iF;
+					a.m_Right = iG;
+					g.m_Parent = iA;
+					a.m_Bounds = b.m_Bounds.Merge(g.m_Bounds);
+					c.m_Bounds = a.m_Bounds.Merge(f.m_Bounds);
+					a.m_Height = 1 + std::max(b.m_Height, g.m_Height);
+					c.m_Height = 1 + std::max(a.m_Height, f.m_Height);
+				}
+				else
+				{
+					c.m_Right = iG;
+					a.m_Right = iF;
+					f.m_Parent = iA;
+					a.m_Bounds = b.m_Bounds.Merge(f.m_Bounds);
+					c.m_Bounds = a.m_Bounds.Merge(g.m_Bounds);
+					a.m_Height = 1 + std::max(b.m_Height, f.m_Height);
+					c.m_Height = 1 + std::max(a.m_Height, g.m_Height);
+				}
+				return iC;
+			}
+
+			// B is too high, the same rotation the other way around.
+			if (balance < -1)
+			{
+				const uint32_t iD = b.m_Left;
+				const uint32_t iE = b.m_Right;
+				Node& d = m_Nodes[iD];
+				Node& e = m_Nodes[iE];
+
+				b.m_Left = iA;
+				b.m_Parent = a.m_Parent;
+				replaceInParent(iB);
+				a.m_Parent = iB;
+
+				if (d.m_Height > e.m_Height)
+				{
+					b.m_Right = iD;
+					a.m_Left = iE;
+					e.m_Parent = iA;
+					a.m_Bounds = c.m_Bounds.Merge(e.m_Bounds);
+					b.m_Bounds = a.m_Bounds.Merge(d.m_Bounds);
+					a.m_Height = 1 + std::max(c.m_Height, e.m_Height);
+					b.m_Height = 1 + std::max(a.m_Height, d.m_Height);
+				}
+				else
+				{
+					b.m_Right = iE;
+					a.m_Left = iD;
+					d.m_Parent = iA;
+					a.m_Bounds = c.m_Bounds.Merge(d.m_Bounds);
+					b.m_Bounds = a.m_Bounds.Merge(e.m_Bounds);
+					a.m_Height = 1 + std::max(c.m_Height, d.m_Height);
+					b.m_Height = 1 + std::max(a.m_Height, e.m_Height);
+				}
+				return iB;
+			}
+
+			return iA;
+		}
+
+		uint32_t SpatialIndex::Build(BuildEntry* a_Entries, size_t a_Count)
+		{
+			if (a_Count == 1)
+			{
+				return a_Entries[0].m_Leaf;
+			}
+
+			// Split along the axis over which the centers are spread the most.
+			Bounds centers = { a_Entries[0].m_Center, a_Entries[0].m_Center };
+			for (size_t i = 1; i < a_Count; i++)
+			{
+				centers = centers.Merge({ a_Entries[i].m_Center, a_Entries[i].m_Center });
+			}
+
+			const float x = centers.m_Max.x - centers.m_Min.x;
+			const float y = centers.m_Max.y - centers.m_Min.y;
+			const float z = centers.m_Max.z - centers.m_Min.z;
+			const int axis = x >= y && x >= z ? 0 : (y >= z ? 1 : 2);
+
+			// Splitting at the middle of the centers is a single pass. Entries that all end up on one side, like when they
+			// share a center, are split at the median instead.
+			const float split = (GetAxis(centers.m_Min, axis) + GetAxis(centers.m_Max, axis)) * 0.5f;
+			BuildEntry* middle = std::partition(a_Entries, a_Entries + a_Count, [axis, split](const BuildEntry& a_Entry)
+			{
+				return GetAxis(a_Entry.m_Center, axis) < split;
+			});
+			size_t half = static_cast<size_t>(middle - a_Entries);
+			if (half == 0 || half == a_Count)
+			{
+				half = a_Count / 2;
+				std::nth_element(a_Entries, a_Entries + half, a_Entries + a_Count, [axis](const BuildEntry& a_Lhs, const BuildEntry& a_Rhs)
+				{
+					return GetAxis(a_Lhs.m_Center, axis) < GetAxis(a_Rhs.m_Center, axis);
+				});
+			}
+
+			const uint32_t left = Build(a_Entries, half);
+			const uint32_t right = Build(a_Entries + half, a_Count - half);
+
+			const uint32_t index = AllocateNode();
+			Node& node = m_Nodes[index];
+			node.m_Left = left;
+			node.m_Right = right;
+			node.m_Height = 1 + std::max(m_Nodes[left].m_Height, m_Nodes[right].m_Height);
+			node.m_Bounds = m_Nodes[left].m_Bounds.Merge(m_Nodes[right].m_Bounds);
+			m_Nodes[left].m_Parent = index;
+			m_Nodes[right].m_Parent = index;
+			return index;
+		}
+	}
+}
\ No newline at end of file
@@ -1,14 +1,406 @@
 #include "gameplay/systems/TransformSystem.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "gameplay/SceneSnapshot.h"
+
 #define JSON_ENTITY_TRANSFORM_COMPONENT_VAR "transform"
 
 namespace gallus
 {
 	namespace gameplay
 	{
+		namespace
+		{
+			// Powers of two, so decoded values quantize back to the same step.
+			constexpr float POSITION_STEPS = 1024.0f; /// Steps per unit.
+			constexpr float ROTATION_STEPS = 64.0f; /// Steps per degree.
+			constexpr float SCALE_STEPS = 4096.0f;
+
+			/// <summary>
+			/// Retrieves a bit for every axis that quantizes to a different step.
+			/// </summary>
+			uint32_t GetChangedAxes(const DirectX::XMFLOAT3& a_Value, const DirectX::XMFLOAT3& a_Previous, float a_Steps)
+			{
+				return (Quantize(a_Value.x, a_Steps) != Quantize(a_Previous.x, a_Steps) ? 1 : 0) |
+					(Quantize(a_Value.y, a_Steps) != Quantize(a_Previous.y, a_Steps) ? 2 : 0) |
+					(Quantize(a_Value.z, a_Steps) != Quantize(a_Previous.z, a_Steps) ? 4 : 0);
+			}
+
+			void WriteAxes(DeltaWriter& a_Writer, uint32_t a_Axes, const DirectX::XMFLOAT3& a_Value, const DirectX::XMFLOAT3& a_Previous, float a_Steps)
+			{
+				const float values[3] = { a_Value.x, a_Value.y, a_Value.z };
+				const float previous[3] = { a_Previous.x, a_Previous.y, a_Previous.z };
+				for (uint32_t axis = 0; axis < 3; axis++)
+				{
+					if (a_Axes & (1 << axis))
+					{
+						a_Writer.WriteSignedVarint(Quantize(values[axis], a_Steps) - Quantize(previous[axis], a_Steps));
+					}
+				}
+			}
+
+			void ReadAxes(DeltaReader& a_Reader, uint32_t a_Axes, DirectX::XMFLOAT3& a_Value, float a_Steps)
+			{
+				float* values[3] = { &a_Value.x, &a_Value.y, &a_Value.z };
+				for (uint32_t axis = 0; axis < 3; axis++)
+				{
+					if (a_Axes & (1 << axis))
+					{
+						*values[axis] = Dequantize(Quantize(*values[axis], a_Steps) + a_Reader.ReadSignedVarint(), a_Steps);
+					}
+				}
+			}
+		}
+
 		std::string TransformSystem::GetPropertyName() const
 		{
 			return JSON_ENTITY_TRANSFORM_COMPONENT_VAR;
 		}
+
+		bool TransformSystem::WriteSnapshot(SnapshotWriter& a_Writer, uint32_t& a_Count) const
+		{
+			const ComponentPool<TransformComponent>& pool = m_Components;
+			const size_t count = pool.size();
+
+			std::vector<DirectX::XMFLOAT3> positions(count);
+			std::vector<DirectX::XMFLOAT3> rotations(count);
+			std::vector<DirectX::XMFLOAT3> scales(count);
+			std::vector<uint32_t> parents(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				const graphics::dx12::Transform& transform = pool[i].Transform();
+				positions[i] = transform.GetPosition();
+				rotations[i] = transform.GetRotation();
+				scales[i] = transform.GetScale();
+				parents[i] = a_Writer.GetOrdinal(pool[i].GetParent());
+			}
+
+			a_Writer.WriteEntities(pool.GetEntities());
+			a_Writer.WriteColumn(positions.data(), count);
+			a_Writer.WriteColumn(rotations.data(), count);
+			a_Writer.WriteColumn(scales.data(), count);
+			a_Writer.WriteColumn(parents.data(), count);
+			a_Count = static_cast<uint32_t>(count);
+			return true;
+		}
+
+		bool TransformSystem::ReadSnapshot(SnapshotReader& a_Reader, uint32_t a_Count)
+		{
+			const uint32_t* entities = a_Reader.ReadColumn<uint32_t>(a_Count);
+			const DirectX::XMFLOAT3* positions = a_Reader.ReadColumn<DirectX::XMFLOAT3>(a_Count);
+			const DirectX::XMFLOAT3* rotations = a_Reader.ReadColumn<DirectX::XMFLOAT3>(a_Count);
+			const DirectX::XMFLOAT3* scales = a_Reader.ReadColumn<DirectX::XMFLOAT3>(a_Count);
+			const uint32_t* parents = a_Reader.ReadColumn<uint32_t>(a_Count);
+			if (!entities || !positions || !rotations || !scales || !parents)
+			{
+				return false;
+			}
+
+			m_Components.Reserve(m_Components.size() + a_Count);
+			for (uint32_t i = 0; i < a_Count; i++)
+			{
+				const EntityID id = a_Reader.GetEntity(entities[i]);
+				if (!id.IsValid())
+				{
+					continue;
+				}
+
+				TransformComponent& component = CreateComponent(id);
+				component.Transform().SetPosition(positions[i]);
+				component.Transform().SetRotation(rotations[i]);
+				component.Transform().SetScale(scales[i]);
+				component.SetParent(a_Reader.GetEntity(parents[i]));
+			}
+			return true;
+		}
+
+		size_t TransformSystem::WriteDelta(DeltaWriter& a_Writer, std::unique_ptr<AbstractComponentPoolCopy>& a_Baseline, uint32_t a_ChangedSince) const
+		{
+			return WriteComponentDelta(a_Writer, a_Baseline, a_ChangedSince, [](DeltaWriter& a_Writer, const TransformComponent& a_Component, const TransformComponent& a_Previous)
+			{
+				const graphics::dx12::Transform& transform = a_Component.Transform();
+				const graphics::dx12::Transform& previous = a_Previous.Transform();
+				const uint32_t position = GetChangedAxes(transform.GetPosition(), previous.GetPosition(), POSITION_STEPS);
+				const uint32_t rotation = GetChangedAxes(transform.GetRotation(), previous.GetRotation(), ROTATION_STEPS);
+				const uint32_t scale = GetChangedAxes(transform.GetScale(), previous.GetScale(), SCALE_STEPS);
+				const bool parent = a_Component.GetParent() != a_Previous.GetParent();
+				a_Writer.WriteBits(position, 3);
+				a_Writer.WriteBits(rotation, 3);
+				a_Writer.WriteBits(scale, 3);
+				a_Writer.WriteBool(parent);
+				if (position == 0 && rotation == 0 && scale == 0 && !parent)
+				{
+					return false;
+				}
+
+				WriteAxes(a_Writer, position, transform.GetPosition(), previous.GetPosition(), POSITION_STEPS);
+				WriteAxes(a_Writer, rotation, transform.GetRotation(), previous.GetRotation(), ROTATION_STEPS);
+				WriteAxes(a_Writer, scale, transform.GetScale(), previous.GetScale(), SCALE_STEPS);
+				if (parent)
+				{
+					a_Writer.WriteEntity(a_Component.GetParent());
+				}
+				return true;
+			});
+		}
+
+		bool TransformSystem::ReadDelta(DeltaReader& a_Reader, std::unique_ptr<AbstractComponentPoolCopy>& a_State, EntitySignatures& a_Signatures)
+		{
+			return ReadComponentDelta(a_Reader, a_State, a_Signatures, [](DeltaReader& a_Reader, const EntityID& a_ID, TransformComponent& a_Component)
+			{
+				const uint32_t position = static_cast<uint32_t>(a_Reader.ReadBits(3));
+				const uint32_t rotation = static_cast<uint32_t>(a_Reader.ReadBits(3));
+				const uint32_t scale = static_cast<uint32_t>(a_Reader.ReadBits(3));
+				const bool parent = a_Reader.ReadBool();
+
+				graphics::dx12::Transform& transform = a_Component.Transform();
+				ReadAxes(a_Reader, position, transform.GetPosition(), POSITION_STEPS);
+				ReadAxes(a_Reader, rotation, transform.GetRotation(), ROTATION_STEPS);
+				ReadAxes(a_Reader, scale, transform.GetScale(), SCALE_STEPS);
+				if (parent)
+				{
+					a_Component.SetParent(a_Reader.ReadEntity());
+				}
+				return true;
+			});
+		}
+
+		void TransformSystem::SetChangeTickSource(std::atomic<uint32_t>* a_ChangeTick)
+		{
+			ECSBaseSystem::SetChangeTickSource(a_ChangeTick);
+			m_ChangeTick = a_ChangeTick;
+		}
+
+		void TransformSystem::ApplyPendingDeletes()
+		{
+			// Removed transforms leave holes in the cache and may orphan children.
+			if (!m_ComponentsToDelete.empty())
+			{
+				m_HierarchyDirty = true;
+			}
+
+			ECSBaseSystem::ApplyPendingDeletes();
+		}
+
+		void TransformSystem::UpdateComponents(float a_DeltaTime)
+		{
+			ECSBaseSystem::UpdateComponents(a_DeltaTime);
+
+			UpdateWorldMatrices();
+		}
+
+		void TransformSystem::GetStats(SystemStats& a_Stats) const
+		{
+			ECSBaseSystem::GetStats(a_Stats);
+			a_Stats.m_AllocatedBytes += m_Order.capacity() * sizeof(EntityID) +
+				m_Parents.capacity() * sizeof(uint32_t) +
+				m_ParentIDs.capacity() * sizeof(EntityID) +
+				m_WorldMatrices.capacity() * sizeof(DirectX::XMFLOAT4X4) +
+				m_Dirty.capacity() * sizeof(uint8_t) +
+				m_Updated.capacity() * sizeof(uint32_t) +
+				m_CacheIndices.capacity() * sizeof(uint32_t);
+		}
+
+		void TransformSystem::OnComponentsRestored()
+		{
+			m_HierarchyDirty = true;
+		}
+
+		uint32_t TransformSystem::GetLayoutVersion() const
+		{
+			return m_LayoutVersion;
+		}
+
+		DirectX::XMMATRIX TransformSystem::GetWorldMatrix(const EntityID& a_ID) const
+		{
+			const uint32_t index = a_ID.GetIndex();
+			if (index >= m_CacheIndices.size() || m_CacheIndices[index] == INVALID_INDEX || m_Order[m_CacheIndices[index]] != a_ID)
+			{
+				return DirectX::XMMatrixIdentity();
+			}
+			return DirectX::XMLoadFloat4x4(&m_WorldMatrices[m_CacheIndices[index]]);
+		}
+
+		void TransformSystem::SetWorldMatrix(const EntityID& a_ID, const DirectX::XMMATRIX& a_WorldMatrix)
+		{
+			TransformComponent* component = m_Components.TryGet(a_ID);
+			if (!component)
+			{
+				return;
+			}
+
+			const DirectX::XMMATRIX parentWorld = GetParentWorldMatrix(a_ID);
+			component->Transform().SetWorldMatrix(a_WorldMatrix * DirectX::XMMatrixInverse(nullptr, parentWorld));
+		}
+
+		DirectX::XMMATRIX TransformSystem::GetParentWorldMatrix(const EntityID& a_ID) const
+		{
+			const TransformComponent* component = m_Components.TryGet(a_ID);
+			if (!component || !m_Components.Contains(component->GetParent()))
+			{
+				return DirectX::XMMatrixIdentity();
+			}
+			return GetWorldMatrix(component->GetParent());
+		}
+
+		void TransformSystem::RebuildHierarchy()
+		{
+			constexpr uint32_t UNKNOWN = UINT32_MAX;
+			constexpr uint32_t IN_PROGRESS = UINT32_MAX - 1;
+
+			const ComponentPool<TransformComponent>& pool = m_Components;
+			const size_t count = pool.size();
+
+			auto getParentSlot = [&pool](size_t a_Slot)
+			{
+				return pool.GetSlot(pool[a_Slot].GetParent());
+			};
+
+			// Resolve the depth of every transform. Chains are walked up until a transform with a known depth or a root is found.
+			std::vector<uint32_t> depths(count, UNKNOWN);
+			std::vector<uint32_t> chain;
+			uint32_t maxDepth = 0;
+			for (size_t slot = 0; slot < count; slot++)
+			{
+				chain.clear();
+				uint32_t current = static_cast<uint32_t>(slot);
+				uint32_t depth = 0;
+				while (true)
+				{
+					if (depths[current] == UNKNOWN)
+					{
+						depths[current] = IN_PROGRESS;
+						chain.push_back(current);
+
+						const uint32_t parent = getParentSlot(current);
+						if (parent == ComponentPool<TransformComponent>::INVALID_SLOT)
+						{
+							break;
+						}
+						current = parent;
+						continue;
+					}
+
+					// Running into a transform of the current chain means the parents form a cycle, the last one becomes a root.
+					depth = depths[current] == IN_PROGRESS ? 0 : depths[current] + 1;
+					break;
+				}
+
+				for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+				{
+					depths[*it] = depth++;
+				}
+				if (!chain.empty())
+				{
+					maxDepth = std::max(maxDepth, depth - 1);
+				}
+			}
+
+			// Counting sort on depth, keeps the pool order within a depth.
+			std::vector<uint32_t> offsets(static_cast<size_t>(maxDepth) + 2, 0);
+			for (size_t slot = 0; slot < count; slot++)
+			{
+				offsets[static_cast<size_t>(depths[slot]) + 1]++;
+			}
+			for (size_t i = 1; i < offsets.size(); i++)
+			{
+				offsets[i] += offsets[i - 1];
+			}
+
+			std::vector<uint32_t> sortedSlots(count);
+			for (size_t slot = 0; slot < count; slot++)
+			{
+				sortedSlots[offsets[depths[slot]]++] = static_cast<uint32_t>(slot);
+			}
+
+			m_Order.resize(count);
+			m_ParentIDs.resize(count);
+			m_Parents.resize(count);
+			m_WorldMatrices.resize(count);
+			m_Dirty.resize(count);
+			m_CacheIndices.assign(m_CacheIndices.size(), INVALID_INDEX);
+			for (size_t i = 0; i < count; i++)
+			{
+				const EntityID& id = pool.GetEntity(sortedSlots[i]);
+				if (id.GetIndex() >= m_CacheIndices.size())
+				{
+					m_CacheIndices.resize(static_cast<size_t>(id.GetIndex()) + 1, INVALID_INDEX);
+				}
+				m_CacheIndices[id.GetIndex()] = static_cast<uint32_t>(i);
+				m_Order[i] = id;
+				m_ParentIDs[i] = pool[sortedSlots[i]].GetParent();
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const uint32_t slot = sortedSlots[i];
+				m_Parents[i] = depths[slot] == 0 ? INVALID_INDEX : m_CacheIndices[pool.GetEntity(getParentSlot(slot)).GetIndex()];
+			}
+
+			m_HierarchyDirty = false;
+			m_LayoutVersion++;
+		}
+
+		void TransformSystem::UpdateWorldMatrices()
+		{
+			// Without a counter every component is stamped with tick 1, so everything has to count as changed.
+			const uint32_t tick = m_ChangeTick ? m_ChangeTick->fetch_add(1, std::memory_order_acq_rel) : 0;
+			const ComponentPool<TransformComponent>& pool = m_Components;
+
+			bool done = false;
+			while (!done)
+			{
+				// A new layout means every cached matrix has to be recomputed.
+				if (m_HierarchyDirty || m_Order.size() != pool.size())
+				{
+					RebuildHierarchy();
+					m_ChangedSince = 0;
+				}
+
+				done = true;
+				m_Updated.clear();
+				for (size_t i = 0; i < m_Order.size(); i++)
+				{
+					const uint32_t slot = pool.GetSlot(m_Order[i]);
+					if (slot == ComponentPool<TransformComponent>::INVALID_SLOT)
+					{
+						// The entity in this entry was replaced by a different one.
+						m_HierarchyDirty = true;
+						done = false;
+						break;
+					}
+
+					const TransformComponent& component = pool[slot];
+					const bool changed = pool.GetVersion(slot) >= m_ChangedSince;
+					if (changed && component.GetParent() != m_ParentIDs[i])
+					{
+						m_HierarchyDirty = true;
+						done = false;
+						break;
+					}
+
+					// Parents come first, so their dirty flag is already known.
+					const uint32_t parent = m_Parents[i];
+					const bool dirty = changed || (parent != INVALID_INDEX && m_Dirty[parent]);
+					m_Dirty[i] = dirty;
+					if (!dirty)
+					{
+						continue;
+					}
+
+					DirectX::XMMATRIX world = component.Transform().GetWorldMatrix();
+					if (parent != INVALID_INDEX)
+					{
+						world = world * DirectX::XMLoadFloat4x4(&m_WorldMatrices[parent]);
+					}
+					DirectX::XMStoreFloat4x4(&m_WorldMatrices[i], world);
+					m_Updated.push_back(static_cast<uint32_t>(i));
+				}
+			}
+
+			m_ChangedSince = tick + 1;
+		}
 	}
 }
\ No newline at end of file
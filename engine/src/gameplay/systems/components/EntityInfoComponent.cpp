@@ -2,6 +2,8 @@
 
 #include <rapidjson/utils.h>
 
+#include "gameplay/systems/EntityInfoSystem.h"
+
 #define JSON_ENTITY_DETAIL_COMPONENT_ACTIVE_VAR "active"
 #define JSON_ENTITY_DETAIL_COMPONENT_NAME_VAR "name"
 
@@ -11,9 +13,24 @@ namespace gallus
 	{
 		void EntityInfoComponent::SetName(const std::string& a_Name)
 		{
+			if (a_Name == m_Name)
+			{
+				return;
+			}
+
+			if (m_System)
+			{
+				m_System->OnNameChanged(m_ID, m_Name, a_Name);
+			}
 			m_Name = a_Name;
 		}
 
+		void EntityInfoComponent::SetOwner(const EntityID& a_ID, EntityInfoSystem* a_System)
+		{
+			m_ID = a_ID;
+			m_System = a_System;
+		}
+
 		void EntityInfoComponent::SetIsActive(bool a_Active)
 		{
 			m_IsActive = a_Active;
@@ -43,7 +60,7 @@ namespace gallus
 			}
 			if (a_Document.HasMember(JSON_ENTITY_DETAIL_COMPONENT_NAME_VAR) && a_Document[JSON_ENTITY_DETAIL_COMPONENT_NAME_VAR].IsString())
 			{
-				m_Name = a_Document[JSON_ENTITY_DETAIL_COMPONENT_NAME_VAR].GetString();
+				SetName(a_Document[JSON_ENTITY_DETAIL_COMPONENT_NAME_VAR].GetString());
 			}
 		}
 	}
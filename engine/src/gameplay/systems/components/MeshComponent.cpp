@@ -4,11 +4,8 @@
 #include "graphics/dx12/Mesh.h"
 #include "graphics/dx12/Material.h"
 #include "graphics/dx12/Shader.h"
-#include "graphics/dx12/Transform.h"
 #include "core/Engine.h"
 
-#include "gameplay/systems/TransformSystem.h"
-
 namespace gallus
 {
 	namespace gameplay
@@ -46,57 +43,21 @@ namespace gallus
 			return m_Mesh;
 		}
 
-		graphics::dx12::Shader* MeshComponent::GetShader()
+		graphics::dx12::Shader* MeshComponent::GetShader() const
 		{
 			return m_Shader;
 		}
 
-		graphics::dx12::Texture* MeshComponent::GetTexture()
+		graphics::dx12::Texture* MeshComponent::GetTexture() const
 		{
 			return m_Texture;
 		}
 
-		graphics::dx12::Material* MeshComponent::GetMaterial()
+		graphics::dx12::Material* MeshComponent::GetMaterial() const
 		{
 			return m_Material;
 		}
 
-		void MeshComponent::Render(std::shared_ptr<graphics::dx12::CommandList> a_CommandList, const EntityID& a_EntityID, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection)
-		{
-			graphics::dx12::Transform transform;
-			transform.SetPosition({ 0.0f, -0.5f, 1.5f });
-
-			if (core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>().HasComponent(a_EntityID))
-			{
-				transform = core::ENGINE.GetECS().GetSystem<gameplay::TransformSystem>().GetComponent(a_EntityID).Transform();
-			}
-
-			if (m_Texture && m_Texture->IsValid())
-			{
-				m_Texture->Bind(a_CommandList);
-			}
-
-			if (m_Material && m_Material->IsValid())
-			{
-				m_Material->Bind(a_CommandList);
-			}
-
-			if (m_Shader)
-			{
-				m_Shader->Bind(a_CommandList);
-			}
-
-			if (m_Mesh)
-			{
-				m_Mesh->Render(a_CommandList, transform, a_CameraView, a_CameraProjection);
-			}
-
-			if (m_Texture && m_Texture->IsValid())
-			{
-				m_Texture->Unbind(a_CommandList);
-			}
-		}
-
 		// TODO:
 		void MeshComponent::Serialize(rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) const
 		{}
@@ -18,6 +18,21 @@ namespace gallus
 			return m_Transform;
 		}
 
+		const graphics::dx12::Transform& TransformComponent::Transform() const
+		{
+			return m_Transform;
+		}
+
+		void TransformComponent::SetParent(const EntityID& a_Parent)
+		{
+			m_Parent = a_Parent;
+		}
+
+		const EntityID& TransformComponent::GetParent() const
+		{
+			return m_Parent;
+		}
+
 		void TransformComponent::Serialize(rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) const
 		{
 			if (!a_Document.IsObject())
@@ -23,8 +23,6 @@
 #endif // _RESOURCE_ATLAS
 
 #include "core/Engine.h"
-#include <gameplay/systems/MeshSystem.h>
-#include <gameplay/systems/TransformSystem.h>
 
 namespace gallus
 {
@@ -822,10 +820,11 @@ namespace gallus
 				const DirectX::XMMATRIX viewMatrix = m_CurrentCamera->GetViewMatrix();
 				const DirectX::XMMATRIX& projectionMatrix = m_CurrentCamera->GetProjectionMatrix();
 
-				// TODO: RENDER LOOP.
-				for (auto& pair : core::ENGINE.GetECS().GetSystem<gameplay::MeshSystem>().GetComponents())
+				// Only the list extracted by the ECS is read here, so the simulation can change components while this frame is recorded.
+				const RenderList& renderList = m_RenderLists.Acquire();
+				for (const RenderItem& renderItem : renderList.m_Items)
 				{
-					pair.second.Render(commandList, pair.first, viewMatrix, projectionMatrix);
+					renderItem.Render(commandList, viewMatrix, projectionMatrix);
 				}
 
 #ifdef _RENDER_TEX
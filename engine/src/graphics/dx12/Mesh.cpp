@@ -4,12 +4,12 @@
 //#define TINYGLTF_GLTF2  // Enforce glTF 2.0 parsing
 #include <tiny_gltf/tiny_gltf.h>
 #include <stb_image.h>
+#include <algorithm>
 #include <filesystem>
 #include <format>
 
 #include "core/Engine.h"
 #include "core/FileUtils.h"
-#include "core/DataStream.h"
 #include "core/logger/Logger.h"
 #include "graphics/dx12/Texture.h"
 #include "graphics/dx12/Shader.h"
@@ -25,16 +25,16 @@ namespace gallus
 			Mesh::Mesh() : DX12Resource()
 			{}
 
-			void Mesh::Render(std::shared_ptr<CommandList> a_CommandList, const Transform& a_Transform, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection)
+			void Mesh::Render(std::shared_ptr<CommandList> a_CommandList, const DirectX::XMMATRIX& a_WorldMatrix, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection)
 			{
+				// The MVP matrix is the same for every part.
+				const DirectX::XMMATRIX mvpMatrix = a_WorldMatrix * a_CameraView * a_CameraProjection;
 				for (auto& meshData : m_MeshData)
 				{
 					a_CommandList->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 					a_CommandList->GetCommandList()->IASetVertexBuffers(0, 1, &meshData->m_VertexBuffer.GetVertexBufferView());
 					a_CommandList->GetCommandList()->IASetIndexBuffer(&meshData->m_IndexBuffer.GetIndexBufferView());
 
-					// Update the MVP matrix
-					DirectX::XMMATRIX mvpMatrix = a_Transform.GetWorldMatrix() * a_CameraView * a_CameraProjection;
 					a_CommandList->GetCommandList()->SetGraphicsRoot32BitConstants(0, sizeof(DirectX::XMMATRIX) / 4, &mvpMatrix, 0);
 
 					a_CommandList->GetCommandList()->DrawIndexedInstanced(static_cast<UINT>(meshData->m_Indices.size()), 1, 0, 0, 0);
@@ -50,9 +50,9 @@ namespace gallus
 			{
 				m_Name = a_Path.stem().generic_wstring();
 
-				// Upload vertex buffer data.
-				core::DataStream data;
-				if (!file::FileLoader::LoadFile(a_Path, data))
+				// Upload vertex buffer data. The model is parsed straight from the mapped file.
+				file::MappedFile data;
+				if (!file::FileLoader::MapFile(a_Path, data, file::MAP_HINT_SEQUENTIAL))
 				{
 					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed loading gltf file %s.", a_Path.generic_string().c_str());
 					return false;
@@ -61,7 +61,7 @@ namespace gallus
 				tinygltf::Model model;
 				tinygltf::TinyGLTF loader;
 				std::string err, warn;
-				if (!loader.LoadBinaryFromMemory(&model, &err, &warn, data.dataAs<unsigned char>(), data.size(), ""))
+				if (!loader.LoadBinaryFromMemory(&model, &err, &warn, data.dataAs<unsigned char>(), static_cast<unsigned int>(data.size()), ""))
 				{
 					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed loading bin file %s.", err.c_str());
 					return false;
@@ -153,6 +153,15 @@ namespace gallus
 							DirectX::XMFLOAT3 color = colors ? DirectX::XMFLOAT3(colors[i * 3], colors[i * 3 + 1], colors[i * 3 + 2]) : DirectX::XMFLOAT3(1.0f, 1.0f, 1.0f);
 							DirectX::XMFLOAT2 uv = uvs ? DirectX::XMFLOAT2(uvs[i * 2], uvs[i * 2 + 1]) : DirectX::XMFLOAT2(0.0f, 0.0f);
 							meshData->m_Vertices.push_back({ position, normal, color, uv });
+
+							if (!m_HasBounds)
+							{
+								m_BoundsMin = position;
+								m_BoundsMax = position;
+								m_HasBounds = true;
+							}
+							m_BoundsMin = DirectX::XMFLOAT3(std::min(m_BoundsMin.x, position.x), std::min(m_BoundsMin.y, position.y), std::min(m_BoundsMin.z, position.z));
+							m_BoundsMax = DirectX::XMFLOAT3(std::max(m_BoundsMax.x, position.x), std::max(m_BoundsMax.y, position.y), std::max(m_BoundsMax.z, position.z));
 						}
 
 						const uint8_t* indices = &indexBuffer.data[indexBufferView.byteOffset + indexAccessor.byteOffset];
@@ -186,6 +195,13 @@ namespace gallus
 			{
 				return !m_MeshData.empty();
 			}
+
+			bool Mesh::GetBounds(DirectX::XMFLOAT3& a_Min, DirectX::XMFLOAT3& a_Max) const
+			{
+				a_Min = m_BoundsMin;
+				a_Max = m_BoundsMax;
+				return m_HasBounds;
+			}
 		}
 	}
 }
\ No newline at end of file
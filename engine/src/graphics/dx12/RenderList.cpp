@@ -0,0 +1,43 @@
+#include "graphics/dx12/RenderList.h"
+
+#include "graphics/dx12/Texture.h"
+#include "graphics/dx12/Mesh.h"
+#include "graphics/dx12/Material.h"
+#include "graphics/dx12/Shader.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			void RenderItem::Render(std::shared_ptr<CommandList> a_CommandList, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection) const
+			{
+				if (m_Texture && m_Texture->IsValid())
+				{
+					m_Texture->Bind(a_CommandList);
+				}
+
+				if (m_Material && m_Material->IsValid())
+				{
+					m_Material->Bind(a_CommandList);
+				}
+
+				if (m_Shader)
+				{
+					m_Shader->Bind(a_CommandList);
+				}
+
+				if (m_Mesh)
+				{
+					m_Mesh->Render(a_CommandList, DirectX::XMLoadFloat4x4(&m_WorldMatrix), a_CameraView, a_CameraProjection);
+				}
+
+				if (m_Texture && m_Texture->IsValid())
+				{
+					m_Texture->Unbind(a_CommandList);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
+#include <climits>
 
 #include "core/Engine.h"
 #include "core/logger/Logger.h"
@@ -111,8 +112,17 @@ namespace gallus
 
 			bool Texture::LoadByPath(const fs::path& a_Path, std::shared_ptr<CommandList> a_CommandList)
 			{
+				// The image is decoded straight from the mapped file.
+				file::MappedFile mappedFile;
+				if (!file::FileLoader::MapFile(a_Path, mappedFile, file::MAP_HINT_SEQUENTIAL) || mappedFile.size() > INT_MAX)
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to load texture: \"%s\".", a_Path.generic_string().c_str());
+					return false;
+				}
+
 				int width, height, channels;
-				stbi_uc* imageData = stbi_load(a_Path.generic_string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+				stbi_uc* imageData = stbi_load_from_memory(mappedFile.dataAs<stbi_uc>(), static_cast<int>(mappedFile.size()), &width, &height, &channels, STBI_rgb_alpha);
+				mappedFile.Unmap();
 				if (!imageData)
 				{
 					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to load texture: \"%s\".", a_Path.generic_string().c_str());